@@ -0,0 +1,59 @@
+/**
+ * @brief Index d'adjacence compact (format CSR) d'un automate.
+ *
+ * Les méthodes out_states/in_states d'Automaton parcourent toutes les
+ * transitions à chaque appel. Adjacency les range une fois pour toutes par
+ * état source (et par état destination pour les prédécesseurs), triées par
+ * lettre puis par état : les parcours de graphe deviennent linéaires.
+ */
+
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <utility>
+#include <vector>
+#include "automaton.h"
+#include "idxset.h"
+#include "memusage.h"
+
+class Adjacency {
+public:
+    // Une transition vue depuis l'une de ses extrémités : la lettre et
+    // l'état situé à l'autre extrémité.
+    struct Edge {
+        char letter;
+        int state;
+    };
+
+    explicit Adjacency(const Automaton& aut);
+
+    // Nombre d'états indexés
+    int size() const;
+
+    // Transitions sortantes de q, triées par lettre puis par destination
+    const Edge* out_begin(int q) const;
+    const Edge* out_end(int q) const;
+
+    // Transitions entrantes dans q, triées par lettre puis par source
+    const Edge* in_begin(int q) const;
+    const Edge* in_end(int q) const;
+
+    // Sous-intervalle des transitions sortantes de q étiquetées par c
+    std::pair<const Edge*, const Edge*> out(int q, char c) const;
+
+    MemoryUsage memory_usage() const;
+
+private:
+    std::vector<int> out_offsets;   // out_edges[out_offsets[q] .. out_offsets[q+1]]
+    std::vector<Edge> out_edges;
+    std::vector<int> in_offsets;
+    std::vector<Edge> in_edges;
+};
+
+// États accessibles depuis srcs, sous forme d'ensemble dense indexé par état
+std::vector<bool> forwardReach(const Adjacency& adj, const IdxSet<int>& srcs);
+
+// États depuis lesquels l'un des états de srcs est accessible
+std::vector<bool> backwardReach(const Adjacency& adj, const IdxSet<int>& srcs);
+
+#endif // ADJACENCY_H
@@ -63,6 +63,9 @@ public:
     // ajoute plusieurs états finaux via un vector de int
     void add_final(const std::vector<int>& states);
 
+    // Ajoute un état final que l'appelant sait ne pas l'être déjà
+    void add_final_unchecked(int e);
+
     bool is_final(int q) const;
 
     // Fonction membre pour ajouter une lettre à l'alphabet
@@ -88,6 +91,10 @@ public:
 
     void add_trans(int src, const IdxSet<char> letters, int dst);
 
+    // Ajoute une transition que l'appelant sait absente de l'automate, sans
+    // le test d'appartenance (linéaire) fait par add_trans.
+    void add_trans_unchecked(int src, char c, int dst);
+
     const IdxSet<int>& get_finals() const;
 
     // out_letters(q) retourne un IdxSet<char> contenant tous les caractères c
@@ -104,6 +111,9 @@ public:
     // une transition de p-c->q
     IdxSet<int> in_states(char c, int q) const;
 
+    // Mémoire occupée par chacun des ensembles de l'automate
+    MemoryUsage memory_usage() const;
+
     // Fonction pour afficher l'automate
     void print() const;
 
@@ -0,0 +1,90 @@
+/**
+ * @brief Vue graphique (QGraphicsView) d'un automate, utilisable sur des
+ * automates de plusieurs millions d'états.
+ *
+ * La vue n'affiche qu'un voisinage borné d'un état central (voir
+ * graphmodel.h) ; un double clic sur un état le prend pour centre, un double
+ * clic sur une composante repliée la déplie. La construction du GraphModel
+ * et le placement sont faits dans un thread de travail, que l'interface
+ * n'attend jamais (seul le destructeur attend la fin du calcul en cours),
+ * puis les éléments sont ajoutés à la scène par lots. Le
+ * dessin dépend du niveau de zoom : en vue éloignée, ni étiquettes ni
+ * flèches ; l'index BSP de la scène écarte les éléments hors de la vue.
+ */
+
+#ifndef AUTOMATONGRAPHVIEW_H
+#define AUTOMATONGRAPHVIEW_H
+
+#include <QGraphicsView>
+#include <QThreadPool>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "automaton.h"
+#include "graphmodel.h"
+
+class AutomatonGraphView : public QGraphicsView
+{
+    Q_OBJECT
+
+public:
+    explicit AutomatonGraphView(QWidget *parent = nullptr);
+    ~AutomatonGraphView();
+
+    // Remplace l'automate affiché ; le voisinage de son premier état
+    // initial est affiché quand le modèle est prêt
+    void setAutomaton(const Automaton& aut);
+
+    // Affiche le voisinage de l'état center
+    void showNeighbourhood(int center);
+
+    // Déplie la composante fortement connexe c dans le voisinage courant
+    void expandComponent(int c);
+
+    // Taille du voisinage affiché
+    static const int radius = 4;
+    static const int maxStates = 400;
+    static const int collapseThreshold = 30;   // Composantes repliées au-delà
+    static const int batchSize = 300;          // Éléments ajoutés par lot
+
+signals:
+    void statusMessage(const QString& message);
+
+protected:
+    void wheelEvent(QWheelEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    QGraphicsScene *scene;
+    QTimer batchTimer;
+
+    std::shared_ptr<const GraphModel> model;
+    std::vector<int> expanded;      // Composantes dépliées
+    int center;
+
+    // Un seul calcul en arrière-plan à la fois : un calcul demandé pendant
+    // qu'un autre tourne attend dans la file de pool, qui ne garde que le
+    // dernier demandé ; generation écarte les résultats d'un calcul devenu
+    // obsolète
+    QThreadPool pool;
+    unsigned generation;
+
+    // Placement en cours d'ajout à la scène
+    GraphLayout pending;
+    size_t nextNode;
+    size_t nextEdge;
+    std::vector<QGraphicsItem*> nodeItems;
+
+    // Lance work dans le thread de travail, après la fin du calcul en
+    // cours, sans l'attendre ; remplace le calcul qui attendait encore
+    void runInBackground(std::function<void()> work);
+
+    // Calcule le placement du voisinage courant en arrière-plan
+    void relayout();
+
+    // Ajoute le lot suivant d'éléments de pending à la scène
+    void insertBatch();
+};
+
+#endif // AUTOMATONGRAPHVIEW_H
@@ -0,0 +1,25 @@
+/**
+ * @brief Génération de code C++ reconnaissant le langage d'un automate
+ * déterministe.
+ *
+ * Chaque état devient une étiquette du code produit : on y teste la fin du
+ * mot, puis l'octet lu par des comparaisons d'intervalles (pour les suites
+ * de lettres consécutives menant au même état) et un switch (pour les
+ * lettres isolées), chaque branche se terminant par un goto vers l'état
+ * suivant. Le matcher obtenu n'accède à aucune table.
+ */
+
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <ostream>
+#include <string>
+#include "automaton.h"
+
+// Écrit dans os la définition de
+//   bool function(std::string_view word);
+// qui donne le même résultat que appartient(dfa, word).
+// Lève std::invalid_argument si dfa n'est pas déterministe.
+void generateMatcher(const Automaton& dfa, const std::string& function, std::ostream& os);
+
+#endif // CODEGEN_H
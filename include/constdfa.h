@@ -0,0 +1,149 @@
+/**
+ * @brief Automates déterministes construits à la compilation.
+ *
+ * constDeterminize() applique la construction des sous-ensembles dans une
+ * fonction constexpr : appelée pour initialiser une variable static
+ * constexpr, elle produit à la compilation une table de transitions
+ * complète, sans allocation dynamique ni coût au démarrage. Les états de
+ * l'automate non déterministe de départ doivent être numérotés de 0 à 63
+ * (un ensemble d'états tient dans un mot de 64 bits).
+ *
+ * Exemple :
+ *   static constexpr auto dfa = constDeterminize<8, 3>(
+ *       {0}, {{0, 'a', 0}, {0, 'b', 1}}, {1});
+ *   static_assert(dfa.appartient("aab"));
+ *
+ * ConstMatcher<dfa> fait de la table un paramètre du type : chaque appel
+ * à ConstMatcher<dfa>::appartient est compilé contre les valeurs
+ * constantes de la table, que le compilateur peut propager et dérouler.
+ */
+
+#ifndef CONSTDFA_H
+#define CONSTDFA_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+
+// Transition src -letter-> dst de l'automate de départ
+struct ConstTrans {
+    int src;
+    char letter;
+    int dst;
+};
+
+template <int MaxStates, int MaxLetters>
+struct ConstDfa {
+    int nb_states = 0;                      // L'état 0 est l'état initial
+    int nb_letters = 0;
+    char letters[MaxLetters] = {};
+    int letterIndex[256] = {};              // -1 si la lettre est absente
+    int delta[MaxStates][MaxLetters] = {};  // -1 si pas de transition
+    bool finals[MaxStates] = {};
+
+    // Même résultat que appartient() sur l'automate de départ
+    constexpr bool appartient(std::string_view word) const {
+        int q = 0;
+        for (char c : word) {
+            int l = letterIndex[static_cast<unsigned char>(c)];
+            if (l < 0) {
+                return false;
+            }
+            q = delta[q][l];
+            if (q < 0) {
+                return false;
+            }
+        }
+        return finals[q];
+    }
+};
+
+// Déterminise à la compilation l'automate (inits, trans, finals).
+// MaxStates borne le nombre d'états du résultat et MaxLetters le nombre de
+// lettres distinctes ; un dépassement, comme un état hors de 0..63, rend
+// l'évaluation non constante et provoque donc une erreur de compilation.
+template <int MaxStates, int MaxLetters>
+constexpr ConstDfa<MaxStates, MaxLetters> constDeterminize(std::initializer_list<int> inits,
+                                                           std::initializer_list<ConstTrans> trans,
+                                                           std::initializer_list<int> finals) {
+    ConstDfa<MaxStates, MaxLetters> dfa{};
+    for (int c = 0; c < 256; ++c) {
+        dfa.letterIndex[c] = -1;
+    }
+
+    uint64_t finalMask = 0;
+    for (int q : finals) {
+        if (q < 0 || q >= 64) {
+            throw std::out_of_range("constDeterminize : état hors de 0..63");
+        }
+        finalMask |= uint64_t(1) << q;
+    }
+    for (const ConstTrans& t : trans) {
+        if (t.src < 0 || t.src >= 64 || t.dst < 0 || t.dst >= 64) {
+            throw std::out_of_range("constDeterminize : état hors de 0..63");
+        }
+        unsigned char c = static_cast<unsigned char>(t.letter);
+        if (dfa.letterIndex[c] < 0) {
+            if (dfa.nb_letters == MaxLetters) {
+                throw std::length_error("constDeterminize : MaxLetters trop petit");
+            }
+            dfa.letters[dfa.nb_letters] = t.letter;
+            dfa.letterIndex[c] = dfa.nb_letters++;
+        }
+    }
+
+    // subsets[i] : ensemble d'états de départ représenté par l'état i
+    uint64_t subsets[MaxStates] = {};
+    uint64_t init = 0;
+    for (int q : inits) {
+        if (q < 0 || q >= 64) {
+            throw std::out_of_range("constDeterminize : état hors de 0..63");
+        }
+        init |= uint64_t(1) << q;
+    }
+    subsets[0] = init;
+    dfa.nb_states = 1;
+
+    for (int i = 0; i < dfa.nb_states; ++i) {
+        dfa.finals[i] = (subsets[i] & finalMask) != 0;
+        for (int l = 0; l < dfa.nb_letters; ++l) {
+            uint64_t next = 0;
+            for (const ConstTrans& t : trans) {
+                if (t.letter == dfa.letters[l] && ((subsets[i] >> t.src) & 1)) {
+                    next |= uint64_t(1) << t.dst;
+                }
+            }
+            if (next == 0) {
+                dfa.delta[i][l] = -1;
+                continue;
+            }
+            int j = 0;
+            while (j < dfa.nb_states && subsets[j] != next) {
+                ++j;
+            }
+            if (j == dfa.nb_states) {
+                if (dfa.nb_states == MaxStates) {
+                    throw std::length_error("constDeterminize : MaxStates trop petit");
+                }
+                subsets[dfa.nb_states++] = next;
+            }
+            dfa.delta[i][l] = j;
+        }
+    }
+    return dfa;
+}
+
+// Matcher spécialisé pour une table donnée
+template <const auto& Dfa>
+struct ConstMatcher {
+    static constexpr bool appartient(std::string_view word) {
+        return Dfa.appartient(word);
+    }
+
+    static constexpr int size() {
+        return Dfa.nb_states;
+    }
+};
+
+#endif // CONSTDFA_H
@@ -0,0 +1,54 @@
+/**
+ * @brief Automate déterministe compilé en table dense état x octet.
+ *
+ * Chaque lettre lue coûte un accès à la table, quel que soit le nombre de
+ * transitions de l'état courant. La table occupe 256 entiers par état.
+ */
+
+#ifndef DFATABLE_H
+#define DFATABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+class DfaTable {
+public:
+    // Lève std::invalid_argument si aut n'est pas déterministe (plusieurs
+    // états initiaux, ou deux transitions de même source et même lettre).
+    explicit DfaTable(const Automaton& aut);
+
+    int size() const;
+
+    // État initial, -1 si l'automate n'en a pas
+    int initial() const;
+
+    // Successeur de q par c, -1 si aucun
+    int next(int q, char c) const {
+        return delta[static_cast<size_t>(q) * 256 + static_cast<unsigned char>(c)];
+    }
+
+    bool is_final(int q) const {
+        return finals[q] != 0;
+    }
+
+    // Même résultat que appartient() sur l'automate d'origine
+    bool appartient(const std::string& word) const;
+
+    // Renumérote les états : order[i] est l'ancien numéro du nouvel état i
+    // (voir renumber.h). Lève std::invalid_argument si order n'est pas une
+    // permutation des états.
+    void renumber(const std::vector<int>& order);
+
+    MemoryUsage memory_usage() const;
+
+private:
+    int nb_states;
+    int init;
+    std::vector<int32_t> delta;     // delta[q * 256 + c]
+    std::vector<uint8_t> finals;
+};
+
+#endif // DFATABLE_H
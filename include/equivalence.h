@@ -0,0 +1,23 @@
+/**
+ * @brief Test d'équivalence de langages par l'algorithme de Hopcroft et Karp.
+ *
+ * Les deux automates sont déterminisés à la volée : seuls les ensembles
+ * d'états atteints par la comparaison sont construits. Les paires déjà
+ * reconnues équivalentes sont fusionnées dans une structure union-find, ce
+ * qui évite de revisiter une paire déductible par transitivité. Pour deux
+ * automates déterministes, les ensembles sont des singletons et le test
+ * est quasi linéaire en leur nombre d'états.
+ */
+
+#ifndef EQUIVALENCE_H
+#define EQUIVALENCE_H
+
+#include <string>
+#include "automaton.h"
+
+// aut1 et aut2 reconnaissent-ils le même langage ? Sinon, et si witness
+// n'est pas nul, *witness reçoit un mot reconnu par exactement l'un des
+// deux automates.
+bool equivalent(const Automaton& aut1, const Automaton& aut2, std::string* witness = nullptr);
+
+#endif // EQUIVALENCE_H
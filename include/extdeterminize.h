@@ -0,0 +1,66 @@
+/**
+ * @brief Déterminisation à mémoire bornée, avec débordement sur disque.
+ *
+ * La construction des sous-ensembles se fait d'abord en mémoire. Quand
+ * l'estimation de la place occupée par la table des sous-ensembles dépasse
+ * le budget, la table est écrite triée dans un fichier temporaire et le
+ * calcul continue par niveaux, en mémoire externe :
+ *  - les successeurs des sous-ensembles du niveau courant sont accumulés
+ *    dans un tampon, trié et vidé sur disque (une « passe ») dès qu'il
+ *    dépasse la moitié du budget ;
+ *  - les passes sont fusionnées, et la fusion est confrontée à la table
+ *    triée des sous-ensembles déjà connus : les nouveaux reçoivent un
+ *    numéro et forment le niveau suivant, les doublons sont éliminés ;
+ *  - les transitions de l'automate déterministe sont écrites au fil de
+ *    l'eau dans un fichier, relu seulement à la fin.
+ * Des limites strictes (temps, nombre d'états, place disque) arrêtent le
+ * calcul avec un compte rendu de ce qui a été construit ; une erreur
+ * d'écriture ou de lecture (disque plein...) l'arrête de la même façon.
+ *
+ * Le budget borne la table des sous-ensembles, pas le résultat :
+ * l'automate déterministe est toujours construit en mémoire à la fin. Un
+ * résultat qui tient sur disque mais pas en mémoire ne peut donc pas être
+ * obtenu par cette fonction.
+ */
+
+#ifndef EXTDETERMINIZE_H
+#define EXTDETERMINIZE_H
+
+#include <cstddef>
+#include <string>
+#include "automaton.h"
+
+struct DeterminizeBudget {
+    size_t memory_bytes = size_t(256) << 20;  // Au-delà, débordement sur disque
+    double max_seconds = 0;                   // Limites strictes, 0 = aucune
+    size_t max_states = 0;
+    size_t max_disk_bytes = 0;
+    std::string tmp_dir;                      // Vide : répertoire temporaire du système
+};
+
+struct DeterminizeReport {
+    enum Status { Complete, TimeLimit, StateLimit, DiskLimit, IoError };
+
+    Status status = Complete;
+    bool spilled = false;           // Passage en mémoire externe
+    size_t nb_states = 0;           // Sous-ensembles découverts
+    size_t nb_expanded = 0;         // Sous-ensembles dont les successeurs sont calculés
+    size_t nb_transitions = 0;
+    size_t nb_runs = 0;             // Passes triées écrites sur disque
+    size_t disk_bytes = 0;          // Total écrit sur disque
+    double seconds = 0;
+    size_t peak_bytes = 0;          // Pic d'allocation, 0 sans suivi (memusage.h)
+
+    // Résumé lisible du compte rendu
+    std::string summary() const;
+};
+
+// Automate déterministe équivalent à aut, comme determinize(aut), ses états
+// étant numérotés en largeur à partir de l'état initial 0. Si une limite
+// stricte est atteinte ou si un fichier temporaire n'a pas pu être écrit ou
+// relu en entier (report.status != Complete), retourne un automate vide et
+// report décrit la partie construite avant l'arrêt.
+Automaton determinize(const Automaton& aut, const DeterminizeBudget& budget,
+                      DeterminizeReport& report);
+
+#endif // EXTDETERMINIZE_H
@@ -0,0 +1,87 @@
+/**
+ * @brief Instantanés immuables d'automates, partageables entre threads.
+ *
+ * Un FrozenAutomaton est construit une fois pour toutes par freeze() : ses
+ * index (adjacence, états finaux, alphabet) sont calculés à la
+ * construction et plus jamais modifiés, si bien que toutes ses méthodes
+ * peuvent être appelées simultanément depuis plusieurs threads sans
+ * verrou. Les instantanés sont partagés par std::shared_ptr ; FrozenSlot
+ * permet de publier une nouvelle version (mise à jour des règles) pendant
+ * que des threads continuent de lire l'ancienne, libérée quand le dernier
+ * lecteur la relâche.
+ */
+
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "adjacency.h"
+#include "automaton.h"
+#include "memusage.h"
+
+class FrozenAutomaton {
+public:
+    explicit FrozenAutomaton(const Automaton& aut);
+
+    FrozenAutomaton(const FrozenAutomaton&) = delete;
+    FrozenAutomaton& operator=(const FrozenAutomaton&) = delete;
+
+    int size() const;
+
+    // États initiaux, triés
+    const std::vector<int>& get_inits() const;
+
+    // Lettres de l'alphabet, triées
+    const std::vector<char>& get_alphabet() const;
+
+    // Temps constant
+    bool is_final(int q) const;
+
+    // Transitions sortantes de q, triées par lettre puis par destination
+    const Adjacency::Edge* out_begin(int q) const;
+    const Adjacency::Edge* out_end(int q) const;
+
+    // Transitions sortantes de q étiquetées par c
+    std::pair<const Adjacency::Edge*, const Adjacency::Edge*> out_states(int q, char c) const;
+
+    // Même résultat que appartient() sur l'automate d'origine
+    bool appartient(const std::string& word) const;
+
+    MemoryUsage memory_usage() const;
+
+private:
+    Adjacency adj;
+    std::vector<int> inits;
+    std::vector<char> alphabet;
+    std::vector<bool> finals;
+};
+
+// Construit l'instantané immuable de aut
+std::shared_ptr<const FrozenAutomaton> freeze(const Automaton& aut);
+
+// Emplacement contenant l'instantané courant. load() et store() sont
+// atomiques : un lecteur obtient toujours une version complète, qu'il
+// garde valide tant qu'il conserve le pointeur retourné.
+class FrozenSlot {
+public:
+    FrozenSlot() = default;
+    explicit FrozenSlot(std::shared_ptr<const FrozenAutomaton> snapshot);
+
+    FrozenSlot(const FrozenSlot&) = delete;
+    FrozenSlot& operator=(const FrozenSlot&) = delete;
+
+    std::shared_ptr<const FrozenAutomaton> load() const;
+
+    void store(std::shared_ptr<const FrozenAutomaton> snapshot);
+
+    // Publie snapshot et retourne la version remplacée
+    std::shared_ptr<const FrozenAutomaton> exchange(std::shared_ptr<const FrozenAutomaton> snapshot);
+
+private:
+    std::shared_ptr<const FrozenAutomaton> current;
+};
+
+#endif // FROZEN_H
@@ -0,0 +1,95 @@
+/**
+ * @brief Préparation de l'affichage graphique d'un grand automate, sans
+ * dépendance à Qt : voisinages, composantes fortement connexes, placement
+ * par couches et export DOT.
+ *
+ * AutomatonGraphView n'affiche jamais tout l'automate : il demande à
+ * layoutNeighbourhood() les états proches d'un état central, dont les
+ * grandes composantes fortement connexes sont repliées en un seul noeud,
+ * puis charge d'autres voisinages à la demande. Ces calculs sont faits hors
+ * du thread de l'interface ; GraphModel n'est jamais modifié après sa
+ * construction et peut être lu depuis plusieurs threads.
+ */
+
+#ifndef GRAPHMODEL_H
+#define GRAPHMODEL_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "adjacency.h"
+#include "automaton.h"
+
+class GraphModel {
+public:
+    explicit GraphModel(const Automaton& aut);
+
+    int size() const;
+    const Adjacency& adjacency() const;
+
+    bool is_init(int q) const;
+    bool is_final(int q) const;
+
+    // Premier état initial, 0 s'il n'y en a pas
+    int first_init() const;
+
+    // Composantes fortement connexes, numérotées de 0 à nb_components() - 1
+    int component(int q) const;
+    int nb_components() const;
+    int component_size(int c) const;
+
+    // États à distance au plus radius de center, les transitions étant
+    // suivies dans les deux sens, par distance croissante et au plus
+    // maxStates. distances, s'il est fourni, reçoit la distance de chacun.
+    std::vector<int> neighbourhood(int center, int radius, size_t maxStates,
+                                   std::vector<int>* distances = nullptr) const;
+
+private:
+    Adjacency adj;
+    std::vector<bool> inits;
+    std::vector<bool> finals;
+    std::vector<int> comp;
+    std::vector<int> compSize;
+};
+
+// Noeud affiché : un état, ou une composante repliée (state == -1)
+struct GraphNode {
+    int state;
+    int component;
+    int size;           // Nombre d'états représentés
+    bool init;
+    bool final;
+    bool frontier;      // A des voisins non affichés
+    double x;
+    double y;
+};
+
+// Arc entre deux noeuds (indices dans GraphLayout::nodes), lettres regroupées
+struct GraphEdge {
+    int from;
+    int to;
+    std::string label;
+};
+
+struct GraphLayout {
+    int center = -1;
+    std::vector<GraphNode> nodes;
+    std::vector<GraphEdge> edges;
+};
+
+// Voisinage de center (voir GraphModel::neighbourhood), placé en couches
+// selon la distance à center. Les composantes de plus de
+// collapseThreshold états sont repliées en un noeud, sauf celles dont le
+// numéro figure dans expanded.
+GraphLayout layoutNeighbourhood(const GraphModel& model, int center, int radius,
+                                size_t maxStates, size_t collapseThreshold,
+                                const std::vector<int>& expanded);
+
+// Lettres triées en intervalles : "a-e,x"
+std::string letterLabel(std::vector<char> letters);
+
+// Export au format DOT écrit au fur et à mesure dans os : un arc par couple
+// d'états reliés, étiqueté par ses lettres regroupées
+void writeDot(const Automaton& aut, std::ostream& os);
+
+#endif // GRAPHMODEL_H
@@ -0,0 +1,131 @@
+/**
+ * @brief Automate déterministe compilé avec une disposition choisie pour
+ * chaque état.
+ *
+ * Dans un automate issu de determinize, quelques états ont des transitions
+ * sur presque tout l'alphabet, mais la plupart n'en ont qu'une à trois.
+ * DfaTable réserve 256 entiers par état ; HybridDfa choisit selon le nombre
+ * k de transitions sortantes :
+ *  - k <= 1 : Single, la lettre et la destination, une comparaison suffit ;
+ *  - 2 <= k <= maxSparse (16) : Sparse, lettres triées comparées toutes à
+ *    la fois par une instruction SSE2 (recherche linéaire sans SSE2) ;
+ *  - k > maxSparse : Dense, une ligne de 256 destinations comme DfaTable.
+ * Tant que la table reste en cache, une ligne dense est plus rapide que la
+ * recherche dans les lettres : les lignes denses sont donc aussi données,
+ * par nombre de transitions décroissant, aux états Sparse jusqu'à
+ * denseBudget octets de lignes au total.
+ *
+ * Les états sont rangés bout à bout dans un seul tableau et les
+ * transitions désignent directement la position de leur destination, avec
+ * sa disposition et son statut final : la lecture d'une lettre ne passe
+ * pas par une table des états. memory_usage() et report() donnent
+ * l'économie par rapport à DfaTable.
+ */
+
+#ifndef HYBRIDDFA_H
+#define HYBRIDDFA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+class HybridDfa {
+public:
+    enum class Layout : uint8_t { Single, Sparse, Dense };
+
+    // Au-delà, la recherche ne tient plus dans un registre SSE2
+    static const int maxSparse = 16;
+
+    // De l'ordre d'un cache L2
+    static const size_t defaultDenseBudget = 1 << 20;
+
+    // Lève std::invalid_argument si aut n'est pas déterministe (plusieurs
+    // états initiaux, ou deux transitions de même source et même lettre).
+    // Avec denseBudget = 0, seuls les états de plus de maxSparse
+    // transitions ont une ligne dense.
+    explicit HybridDfa(const Automaton& aut, size_t denseBudget = defaultDenseBudget);
+
+    int size() const;
+
+    // État initial, -1 si l'automate n'en a pas
+    int initial() const;
+
+    // Successeur de q par c, -1 si aucun
+    int next(int q, char c) const {
+        int32_t h = step(handles[q], c);
+        return h < 0 ? -1 : code[position(h) - 1];
+    }
+
+    bool is_final(int q) const {
+        return (handles[q] & finalBit) != 0;
+    }
+
+    // Même résultat que appartient() sur l'automate d'origine
+    bool appartient(const std::string& word) const;
+
+    Layout layout(int q) const;
+
+    // Nombre d'états ayant la disposition l
+    int count(Layout l) const;
+
+    MemoryUsage memory_usage() const;
+
+    // Octets qu'occuperait la DfaTable du même automate
+    size_t dense_bytes() const;
+
+    // Répartition des dispositions et économie par rapport à DfaTable
+    std::string report() const;
+
+private:
+    // Un état est désigné par position << 3, plus finalBit s'il est final,
+    // plus sa disposition ; -1 pour l'absence de transition. Dans code, à
+    // partir de position :
+    //  - Single : lettre (256 s'il n'a pas de transition), destination ;
+    //  - Sparse : 16 octets de lettres (complétées par la première, que la
+    //    comparaison trouve en premier), puis les destinations ;
+    //  - Dense : 256 destinations.
+    // code[position - 1] est le numéro de l'état.
+    static const int32_t finalBit = 4;
+    static const int32_t layoutMask = 3;
+
+    int init;
+    std::vector<int32_t> handles;   // handles[q] : désignation de l'état q
+    std::vector<int32_t> code;
+
+    static size_t position(int32_t h) {
+        return static_cast<size_t>(h) >> 3;
+    }
+
+    int32_t step(int32_t h, char c) const {
+        const int32_t* s = code.data() + position(h);
+        unsigned char u = static_cast<unsigned char>(c);
+        switch (static_cast<Layout>(h & layoutMask)) {
+        case Layout::Dense:
+            return s[u];
+        case Layout::Single:
+            return s[0] == u ? s[1] : -1;
+        default:
+            break;
+        }
+#if defined(__SSE2__)
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+        return mask != 0 ? s[4 + __builtin_ctz(static_cast<unsigned>(mask))] : -1;
+#else
+        const unsigned char* letters = reinterpret_cast<const unsigned char*>(s);
+        for (int i = 0; i < maxSparse; ++i) {
+            if (letters[i] == u) {
+                return s[4 + i];
+            }
+        }
+        return -1;
+#endif
+    }
+};
+
+#endif // HYBRIDDFA_H
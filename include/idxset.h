@@ -15,6 +15,7 @@
 #include <vector>
 #include <stdexcept> // Pour std::out_of_range
 #include <algorithm> // Pour std::find
+#include "memusage.h"
 
 // Pour tout objet mis dans un IdxSet, l'opérateur == DOIT avoir été redéfini
 // pour ne pas simplement tester une égalité d'adresses mémoires mais une
@@ -57,6 +58,12 @@ public:
         }
     }
 
+    // Ajoute e sans tester s'il est déjà présent (temps constant).
+    // L'appelant DOIT garantir que e n'appartient pas déjà à l'ensemble.
+    void add_unchecked(const T& e) {
+        elements.push_back(e);
+    }
+
     // Pour ajouter le contenu d'un vector
     void add(const std::vector<T>& vec) {
         for (const T& e : vec) {
@@ -115,6 +122,13 @@ public:
         return elements.empty();  // Utilise la méthode empty() du std::vector pour vérifier si l'ensemble est vide
     }
 
+    // Mémoire occupée par les éléments (voir memusage.h)
+    MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        usage.add_vector("elements", elements);
+        return usage;
+    }
+
 
     // Fonction index(e) utilisant equals : retourne l'index de e ou lève
     // l'exception std::out_of_range si e ne fait pas partie de l'ensemble.
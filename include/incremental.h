@@ -0,0 +1,129 @@
+/**
+ * @brief Déterminisation maintenue incrémentalement pendant que l'automate
+ * non déterministe grandit.
+ *
+ * IncrementalDeterminizer garde l'état de la construction par sous-ensembles :
+ * les sous-ensembles internés, leurs transitions, et pour chaque état du
+ * NFA la liste des sous-ensembles qui le contiennent. Les mutations passent
+ * par lui :
+ *  - add_trans(p, c, q) ne recalcule que la transition par c des
+ *    sous-ensembles contenant p, puis explore les sous-ensembles nouveaux ;
+ *  - add_final(q) ne touche que les sous-ensembles contenant q ;
+ *  - add_init(q) interne le nouveau sous-ensemble initial et explore ce
+ *    qu'il rend accessible.
+ * Le coût d'une mutation est donc proportionnel au nombre de sous-ensembles
+ * concernés et nouveaux, non à la taille de l'automate.
+ *
+ * Chaque sous-ensemble compte les transitions qui y mènent (plus une pour
+ * l'initial) : quand une mutation redirige la dernière, il est libéré
+ * aussitôt, avec ceux qui ne restaient accessibles que par lui, et n'est
+ * plus mis à jour. Les cycles de sous-ensembles inaccessibles échappent à
+ * ce comptage : dès que le nombre de sous-ensembles internés double depuis
+ * le dernier nettoyage, seuls les accessibles depuis l'initial sont gardés
+ * et renumérotés. Le coût des mutations reste ainsi lié à la taille de la
+ * partie accessible, et non à l'historique des mutations.
+ *
+ * dfa() et complement() ne construisent que la partie accessible, avec le
+ * même langage que determinize(nfa()) et complement(nfa()).
+ */
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+class IncrementalDeterminizer {
+public:
+    IncrementalDeterminizer();
+    explicit IncrementalDeterminizer(const Automaton& nfa);
+
+    // Mutations de l'automate non déterministe
+    int newstate();
+    void add_init(int q);
+    void add_trans(int src, char c, int dst);
+    void add_final(int q);
+
+    const Automaton& nfa() const;
+
+    // Nombre de sous-ensembles internés et non libérés, y compris des
+    // inaccessibles qui attendent le prochain nettoyage
+    int nb_subsets() const;
+
+    MemoryUsage memory_usage() const;
+
+    // Lecture de word sur les sous-ensembles déjà calculés
+    bool appartient(const std::string& word) const;
+
+    // Partie accessible de l'automate déterminisé, état initial 0,
+    // numérotée en largeur d'abord
+    Automaton dfa() const;
+
+    // Complété par un puits sur l'alphabet de dfa(), finaux inversés
+    Automaton complement() const;
+
+private:
+    struct SubsetHash {
+        size_t operator()(const std::vector<int>& s) const;
+    };
+
+    // Sous-ensemble à explorer. S'il vaut base plus les états extra, et que
+    // base est déjà exploré, ses transitions se déduisent de celles de
+    // base sans reparcourir les transitions de tous ses états.
+    struct Pending {
+        int id;
+        int base;
+        std::vector<int> extra;
+    };
+
+    Automaton automaton;                        // Le NFA
+    std::vector<std::vector<std::pair<char, int>>> out;  // Transitions du NFA, triées
+    std::vector<bool> nfaFinal;
+
+    std::vector<std::vector<int>> subsets;      // Sous-ensembles triés
+    std::unordered_map<std::vector<int>, int, SubsetHash> ids;
+    std::vector<std::vector<std::pair<char, int>>> delta;  // Transitions, triées par lettre
+    std::vector<bool> finals;
+    std::vector<std::vector<int>> containing;   // État du NFA -> sous-ensembles le contenant
+    int init;                                   // Sous-ensemble initial
+    std::vector<int> refs;                      // Transitions entrantes, +1 pour l'initial
+    std::vector<bool> alive;                    // false une fois libéré
+    std::vector<bool> explored;                 // Transitions calculées
+    size_t nb_dead;                             // Numéros libérés en attente du nettoyage
+    size_t compactAt;                           // Taille déclenchant le prochain nettoyage
+
+    // Numéro du sous-ensemble s ; s'il est nouveau, il est ajouté à
+    // pending, avec base et extra si s vaut base plus les états extra
+    int intern(const std::vector<int>& s, std::vector<Pending>& pending, int base = -1,
+               const std::vector<int>& extra = {});
+
+    // Calcule les transitions des sous-ensembles en attente
+    void explore(std::vector<Pending>& pending);
+
+    // Fixe la transition de d par c et renvoie l'ancienne cible (-1 s'il
+    // n'y en avait pas), que l'appelant doit relâcher
+    int setTransition(int d, char c, int target);
+    int transition(int d, char c) const;
+
+    // Compte une référence de plus ou de moins vers d ; à zéro, d est
+    // libéré avec ce qui n'était plus référencé que par lui
+    void acquire(int d);
+    void release(int d);
+
+    // Ne garde que les sous-ensembles accessibles, renumérotés en largeur
+    // d'abord, si le nombre de sous-ensembles internés a atteint compactAt
+    void compactIfNeeded();
+
+    // Agrandit les index du NFA pour contenir l'état q
+    void growNfa(int q);
+
+    // Sous-ensembles accessibles en largeur d'abord, et leur numéro dans
+    // cet ordre (-1 pour les inaccessibles)
+    void reachable(std::vector<int>& order, std::vector<int>& number) const;
+};
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,79 @@
+/**
+ * @brief Expressions d'automates évaluées à la demande.
+ *
+ * lazyComplement, lazyIntersection, lazyUnion, lazyTrim et lazyDeterminize
+ * ne calculent rien : ils construisent un graphe de noeuds, chacun sachant
+ * produire ses états initiaux et les successeurs d'un état quand on les
+ * lui demande. Seuls les états atteints par la requête finale (appartient,
+ * emptyLanguage, shortestWord ou materialize) sont construits, dans chaque
+ * noeud du graphe.
+ *
+ * Les noeuds mémorisent les états déjà construits : un même graphe ne doit
+ * pas être interrogé simultanément depuis plusieurs threads.
+ *
+ * Différences avec les opérations de operations.h :
+ *  - le complémentaire est pris par rapport à l'alphabet du noeud
+ *    (celui de l'automate pour lazy(), l'intersection ou l'union des
+ *    alphabets pour lazyIntersection/lazyUnion) ;
+ *  - lazyTrim ne change pas le langage, il n'a donc d'effet que sur
+ *    materialize(), dont il retire les états non co-accessibles.
+ */
+
+#ifndef LAZY_H
+#define LAZY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+class LazyNode {
+public:
+    virtual ~LazyNode() = default;
+
+    // États initiaux ; les états sont des numéros propres au noeud
+    virtual std::vector<int> initials() = 0;
+
+    virtual bool is_final(int s) = 0;
+
+    // Successeurs de s par c, triés et sans doublon
+    virtual std::vector<int> successors(int s, char c) = 0;
+
+    // Lettres pour lesquelles s peut avoir des successeurs, triées
+    virtual std::vector<char> out_letters(int s) = 0;
+
+    // Lettres de l'alphabet du noeud, triées
+    virtual const std::vector<char>& alphabet() const = 0;
+
+    // Le résultat de materialize() doit-il être émondé ?
+    virtual bool trimmed() const {
+        return false;
+    }
+
+    // États construits jusqu'ici par le noeud et par ses descendants,
+    // préfixés par "a." et "b." (ou "child.") ; un sous-graphe partagé est
+    // compté à chacune de ses occurrences.
+    virtual MemoryUsage memory_usage() const = 0;
+};
+
+typedef std::shared_ptr<LazyNode> LazyAutomaton;
+
+// Feuille du graphe : l'automate aut (copié)
+LazyAutomaton lazy(const Automaton& aut);
+
+LazyAutomaton lazyDeterminize(LazyAutomaton a);
+LazyAutomaton lazyComplement(LazyAutomaton a);
+LazyAutomaton lazyIntersection(LazyAutomaton a, LazyAutomaton b);
+LazyAutomaton lazyUnion(LazyAutomaton a, LazyAutomaton b);
+LazyAutomaton lazyTrim(LazyAutomaton a);
+
+// Requêtes : n'explorent que les états nécessaires
+bool appartient(LazyAutomaton a, const std::string& word);
+bool emptyLanguage(LazyAutomaton a);
+bool shortestWord(LazyAutomaton a, std::string& word);
+
+// Construit explicitement la partie accessible de a
+Automaton materialize(LazyAutomaton a);
+
+#endif // LAZY_H
@@ -2,6 +2,8 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include "automaton.h"
+#include "opcache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -20,9 +22,12 @@ public:
 private slots:
     void on_testAutomatonButton_clicked();
     void on_testIdxSetButton_clicked();
+    void exportDot();
 
 private:
     Ui::MainWindow *ui;
+    Automaton shownAutomaton;   // Automate de la vue graphique
+    OpCache operations;         // Résultats gardés d'un clic à l'autre
     void testAutomaton();
     void testIdxSet();
 };
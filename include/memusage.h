@@ -0,0 +1,91 @@
+/**
+ * @brief Mesure de l'occupation mémoire des automates et des moteurs.
+ *
+ * Les classes (IdxSet, Automaton, Adjacency, DfaTable, HybridDfa,
+ * FrozenAutomaton, RangeAutomaton, ShiftAndMatcher, Matcher, Searcher,
+ * OpCache) et les noeuds des expressions de lazy.h fournissent
+ * memory_usage(), qui détaille par composant les octets utilisés et les
+ * octets réservés (capacité des vecteurs) ; la différence est la capacité
+ * inutilisée. Pour les tables de hachage, la place est estimée d'après le
+ * nombre d'éléments et de cases.
+ *
+ * PeakMemoryScope mesure le pic d'allocation pendant une opération. Il ne
+ * compte que si le programme est construit avec l'option CMake
+ * AUTOMATON_TRACK_ALLOCATIONS, qui remplace les opérateurs new et delete
+ * globaux par des versions comptant les octets alloués.
+ */
+
+#ifndef MEMUSAGE_H
+#define MEMUSAGE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class MemoryUsage {
+public:
+    struct Component {
+        std::string name;
+        size_t used;        // Octets occupés par les éléments
+        size_t reserved;    // Octets réservés, capacité inutilisée comprise
+    };
+
+    void add(const std::string& name, size_t used, size_t reserved);
+
+    // Ajoute les composants de other en préfixant leur nom par "prefix."
+    void add(const std::string& prefix, const MemoryUsage& other);
+
+    template <typename T>
+    void add_vector(const std::string& name, const std::vector<T>& v) {
+        add(name, v.size() * sizeof(T), v.capacity() * sizeof(T));
+    }
+
+    void add_vector(const std::string& name, const std::vector<bool>& v) {
+        add(name, (v.size() + 7) / 8, (v.capacity() + 7) / 8);
+    }
+
+    // Table à noeuds chaînés (std::unordered_map) : un noeud par élément,
+    // avec le pointeur suivant et le haché, et un pointeur par case. Ce
+    // que les éléments allouent eux-mêmes n'est pas compté.
+    template <typename Map>
+    void add_hash_map(const std::string& name, const Map& m) {
+        size_t node = sizeof(typename Map::value_type) + 2 * sizeof(void*);
+        size_t bytes = m.size() * node + m.bucket_count() * sizeof(void*);
+        add(name, bytes, bytes);
+    }
+
+    const std::vector<Component>& components() const;
+
+    size_t used() const;
+    size_t reserved() const;
+
+    // Une ligne par composant puis le total
+    std::string report() const;
+
+private:
+    std::vector<Component> parts;
+};
+
+// 1536 -> "1.5 Kio"
+std::string formatBytes(size_t bytes);
+
+// Pic des octets alloués pendant la durée de vie de l'objet, au-delà de
+// ceux déjà alloués à sa création. Les portées ne s'imbriquent pas : en
+// créer une remet à zéro le pic des autres.
+class PeakMemoryScope {
+public:
+    PeakMemoryScope();
+
+    // Toujours 0 si le suivi des allocations n'est pas compilé
+    size_t peak() const;
+
+    // Octets alloués et non libérés depuis le début du programme
+    static size_t allocated();
+
+    static bool enabled();
+
+private:
+    size_t start;
+};
+
+#endif // MEMUSAGE_H
@@ -0,0 +1,108 @@
+/**
+ * @brief Mémoïsation des opérations coûteuses sur les automates.
+ *
+ * Les résultats sont indexés par l'opération et par une empreinte
+ * structurelle de chaque opérande, indépendante de l'ordre dans lequel
+ * les états et transitions ont été ajoutés aux IdxSet. Le cache est borné
+ * (politique LRU), utilisable depuis plusieurs threads, et peut être
+ * doublé d'un répertoire local où les résultats sont conservés d'une
+ * exécution à l'autre.
+ */
+
+#ifndef OPCACHE_H
+#define OPCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+// Empreinte de 128 bits d'un automate
+struct AutomatonHash {
+    uint64_t h1;
+    uint64_t h2;
+
+    bool operator==(const AutomatonHash& other) const {
+        return h1 == other.h1 && h2 == other.h2;
+    }
+
+    // Représentation hexadécimale sur 32 caractères
+    std::string hex() const;
+};
+
+// Empreinte canonique : deux automates ayant le même nombre d'états et les
+// mêmes ensembles d'états initiaux, finaux, de lettres et de transitions
+// ont la même empreinte, quel que soit l'ordre d'insertion. Coût en
+// O(T log T) pour T transitions : un appelant qui réutilise un opérande
+// non modifié peut garder son empreinte et la passer aux opérations.
+AutomatonHash structuralHash(const Automaton& aut);
+
+class OpCache {
+public:
+    enum Operation { Determinize, Complement, Intersection, Trim, Minimize };
+
+    // capacity : nombre maximal de résultats gardés en mémoire.
+    // directory : répertoire de persistance, vide pour ne rien écrire.
+    explicit OpCache(size_t capacity, const std::string& directory = "");
+
+    // Retourne le résultat de op sur les opérandes d'empreintes operands,
+    // en appelant compute() s'il n'est ni en mémoire ni sur disque.
+    Automaton get_or_compute(Operation op, const std::vector<AutomatonHash>& operands,
+                             const std::function<Automaton()>& compute);
+
+    // Comme get_or_compute, sans copier le résultat gardé en mémoire
+    std::shared_ptr<const Automaton> get_shared(Operation op,
+                                                const std::vector<AutomatonHash>& operands,
+                                                const std::function<Automaton()>& compute);
+
+    // Versions mémoïsées des opérations de operations.h. Le résultat est
+    // partagé avec le cache, sans copie. Sans empreinte fournie, celle de
+    // chaque opérande est recalculée à chaque appel, succès compris ; avec
+    // l'empreinte (structuralHash de l'opérande non modifié), un succès ne
+    // coûte que la recherche de la clé.
+    std::shared_ptr<const Automaton> determinize(const Automaton& aut);
+    std::shared_ptr<const Automaton> determinize(const Automaton& aut, const AutomatonHash& hash);
+    std::shared_ptr<const Automaton> complement(const Automaton& aut);
+    std::shared_ptr<const Automaton> complement(const Automaton& aut, const AutomatonHash& hash);
+    std::shared_ptr<const Automaton> intersection(const Automaton& aut1, const Automaton& aut2);
+    std::shared_ptr<const Automaton> intersection(const Automaton& aut1, const AutomatonHash& hash1,
+                                                  const Automaton& aut2, const AutomatonHash& hash2);
+    std::shared_ptr<const Automaton> trim(const Automaton& aut);
+    std::shared_ptr<const Automaton> trim(const Automaton& aut, const AutomatonHash& hash);
+
+    // Vide le cache mémoire (le répertoire de persistance est conservé)
+    void clear();
+
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+
+    // Résultats gardés en mémoire (y compris ceux encore partagés avec des
+    // appelants de get_shared) et index des clés
+    MemoryUsage memory_usage() const;
+
+private:
+    typedef std::pair<std::string, std::shared_ptr<const Automaton>> Entry;
+
+    size_t capacity;
+    std::string directory;
+    std::list<Entry> lru;   // Le plus récemment utilisé en tête
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t nb_hits;
+    size_t nb_misses;
+    mutable std::mutex mutex;
+
+    // Cherche key en mémoire puis sur disque ; remplit result si trouvé.
+    std::shared_ptr<const Automaton> lookup(const std::string& key);
+    void insert(const std::string& key, const std::shared_ptr<const Automaton>& aut);
+    std::string path(const std::string& key) const;
+};
+
+#endif // OPCACHE_H
@@ -0,0 +1,58 @@
+/**
+ * @brief Opérations classiques sur les automates (appartenance,
+ * accessibilité, trim, intersection, déterminisation, complémentaire).
+ *
+ * Ces implémentations directes, construites sur IdxSet, servent de
+ * référence aux moteurs spécialisés.
+ */
+
+#ifndef OPERATIONS_H
+#define OPERATIONS_H
+
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "idxset.h"
+
+bool vectMeme(const std::vector<int> &vect, int n);
+
+std::vector<int> vectIntersection(const std::vector<int> &vect1, const std::vector<int> &vect2);
+
+// États atteints depuis srcs en lisant la lettre c
+IdxSet<int> succesors(const Automaton &aut, const IdxSet<int> &srcs, char c);
+
+// États atteints depuis srcs en lisant le mot word
+IdxSet<int> succesors(const Automaton &aut, const IdxSet<int> &srcs, const std::string &word);
+
+// Le mot word est-il reconnu par aut ?
+bool appartient(const Automaton &aut, const std::string &word);
+
+// États accessibles depuis srcs
+IdxSet<int> succesorsStar(const Automaton &aut, const IdxSet<int> &srcs);
+
+// Le langage reconnu par aut est-il vide ?
+bool emptyLanguage(Automaton aut);
+
+// États co-accessibles depuis srcs
+IdxSet<int> predecessorsStar(const Automaton &aut, const IdxSet<int> &srcs);
+
+// Automate restreint aux états accessibles et co-accessibles, renumérotés
+// de façon dense. old2new reçoit le nouveau numéro de chaque état (-1 si
+// l'état a été supprimé).
+Automaton trim(const Automaton &aut, std::vector<int> &old2new);
+Automaton trim(const Automaton &aut);
+
+// Automate restreint aux états q tels que keep[q], renumérotés comme par trim
+Automaton restrictStates(const Automaton &aut, const std::vector<bool> &keep,
+                         std::vector<int> &old2new);
+
+// Automate produit reconnaissant l'intersection des langages
+Automaton intersection(const Automaton &aut1, const Automaton &aut2);
+
+// Automate déterministe équivalent (construction des sous-ensembles)
+Automaton determinize(const Automaton &aut);
+
+// Automate déterministe complet reconnaissant le complémentaire
+Automaton complement(const Automaton &aut);
+
+#endif // OPERATIONS_H
@@ -0,0 +1,89 @@
+/**
+ * @brief Accessibilité et composantes fortement connexes calculées en
+ * parallèle, pour les automates de plusieurs millions d'états.
+ *
+ * parallelForwardReach et parallelBackwardReach font un parcours en largeur
+ * par niveaux sur l'index d'adjacence. Les états visités sont marqués dans
+ * un ensemble de bits atomique ; chaque niveau est traité soit de haut en
+ * bas (les threads se partagent la frontière et suivent ses transitions),
+ * soit de bas en haut (les threads se partagent les états non visités et
+ * cherchent parmi leurs prédécesseurs un état déjà visité), selon la
+ * règle de Beamer : de bas en haut dès que la frontière dépasse un
+ * quatorzième des états non visités, de nouveau de haut en bas quand elle
+ * redescend sous un vingt-quatrième des états. Les petites frontières
+ * sont traitées par un seul thread : sur un graphe en longue chaîne, le
+ * parcours reste plus lent que forwardReach, qui n'a pas d'opérations
+ * atomiques. Avec un seul thread, ce sont forwardReach et backwardReach qui
+ * sont appelés.
+ *
+ * parallelScc décompose le graphe en composantes fortement connexes :
+ *  1. élagage parallèle des états sans prédécesseur ou sans successeur
+ *     restant, qui forment chacun leur propre composante ;
+ *  2. avant-arrière (FW-BW) depuis un pivot de degré maximal avec les
+ *     parcours parallèles : l'intersection des deux parcours est la
+ *     composante du pivot, en général la composante géante ;
+ *  3. les trois parties restantes, indépendantes, sont réparties entre les
+ *     threads, qui les découpent à leur tour par FW-BW ou, en dessous
+ *     d'une taille, par l'algorithme de Tarjan.
+ *
+ * nb_threads = 0 : autant de threads que de coeurs disponibles. Les
+ * résultats ne dépendent ni du nombre de threads ni des seuils de
+ * ParallelOptions.
+ */
+
+#ifndef PARALLELGRAPH_H
+#define PARALLELGRAPH_H
+
+#include <cstddef>
+#include <vector>
+#include "adjacency.h"
+#include "automaton.h"
+#include "idxset.h"
+
+// Nombre de threads et seuils de découpe. Les valeurs par défaut
+// conviennent aux automates de plusieurs millions d'états ; des seuils
+// plus bas font passer de petits graphes par les chemins parallèles.
+struct ParallelOptions {
+    unsigned nb_threads = 0;
+    size_t min_parallel_frontier = 1024;            // Frontière parcourue par un seul thread en dessous
+    size_t min_parallel_states = size_t(1) << 16;   // Passes sur tous les états, idem
+    size_t max_tarjan_part = size_t(1) << 16;       // Parties laissées à Tarjan plutôt qu'à FW-BW
+};
+
+// Mêmes résultats que forwardReach et backwardReach (adjacency.h)
+std::vector<bool> parallelForwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                       unsigned nb_threads = 0);
+std::vector<bool> parallelBackwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                        unsigned nb_threads = 0);
+std::vector<bool> parallelForwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                       const ParallelOptions& options);
+std::vector<bool> parallelBackwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                        const ParallelOptions& options);
+
+struct SccDecomposition {
+    std::vector<int> component;     // Composante de chaque état
+    std::vector<int> sizes;         // Nombre d'états de chaque composante
+
+    int count() const;
+};
+
+// Composantes numérotées dans l'ordre de leur plus petit état
+SccDecomposition parallelScc(const Adjacency& adj, unsigned nb_threads = 0);
+SccDecomposition parallelScc(const Adjacency& adj, const ParallelOptions& options);
+
+// Mêmes composantes par l'algorithme de Tarjan seul, sur tout le graphe et
+// dans le thread appelant : la référence séquentielle de parallelScc
+SccDecomposition tarjanScc(const Adjacency& adj);
+
+// Comme trim (operations.h), accessibilité calculée en parallèle
+Automaton parallelTrim(const Automaton& aut, std::vector<int>& old2new, unsigned nb_threads = 0);
+
+// Comme emptyLanguage (operations.h)
+bool parallelEmptyLanguage(const Automaton& aut, unsigned nb_threads = 0);
+
+// Le langage reconnu est-il infini ? C'est le cas si et seulement si un
+// état accessible et co-accessible est sur un cycle : dans une composante
+// de plus d'un état, ou portant une boucle.
+bool infiniteLanguage(const Automaton& aut, unsigned nb_threads = 0);
+
+#endif // PARALLELGRAPH_H
@@ -0,0 +1,23 @@
+/**
+ * @brief Intersection n-aire par produit direct de plusieurs automates.
+ *
+ * Au lieu d'enchaîner k-1 intersections binaires, chacune matérialisée, on
+ * explore directement les k-uplets d'états accessibles. Un k-uplet dont
+ * l'une des composantes ne peut atteindre aucun état final de son automate
+ * n'est jamais créé. L'exploration se fait par niveaux : les successeurs
+ * des k-uplets d'un même niveau sont calculés en parallèle, puis numérotés
+ * séquentiellement pour que le résultat ne dépende pas du nombre de threads.
+ */
+
+#ifndef PRODUCT_H
+#define PRODUCT_H
+
+#include <vector>
+#include "automaton.h"
+
+// Automate reconnaissant l'intersection des langages de auts.
+// nb_threads = 0 : autant de threads que de coeurs disponibles.
+// Lève std::invalid_argument si auts est vide.
+Automaton intersection(const std::vector<Automaton>& auts, unsigned nb_threads = 0);
+
+#endif // PRODUCT_H
@@ -0,0 +1,125 @@
+/**
+ * @brief Automates dont les transitions sont étiquetées par des ensembles
+ * d'intervalles de points de code Unicode.
+ *
+ * Une transition « tout caractère imprimable » est un seul intervalle au
+ * lieu de 95 transitions parallèles, et tout point de code de 0 à
+ * 0x10FFFF est représentable. determinize, intersection et complement
+ * travaillent sur la partition minimale en intervalles disjoints des
+ * étiquettes sortantes, sans jamais énumérer les lettres.
+ *
+ * Les mots sont soit des suites de points de code (std::u32string), soit
+ * des chaînes UTF-8 décodées à la volée par appartientUtf8.
+ */
+
+#ifndef RANGEAUTOMATON_H
+#define RANGEAUTOMATON_H
+
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+// Plus grand point de code Unicode
+const char32_t maxCodePoint = 0x10FFFF;
+
+// Intervalle fermé [lo, hi] de points de code
+struct CodeRange {
+    char32_t lo;
+    char32_t hi;
+};
+
+// Ensemble de points de code, représenté par des intervalles triés,
+// disjoints et non contigus
+class RangeSet {
+public:
+    RangeSet() = default;
+    RangeSet(char32_t lo, char32_t hi);
+
+    // Tous les points de code
+    static RangeSet all();
+
+    void add(char32_t lo, char32_t hi);
+    void add(const RangeSet& other);
+
+    bool contains(char32_t c) const;
+    bool empty() const;
+
+    RangeSet intersect(const RangeSet& other) const;
+
+    // Complémentaire dans [0, maxCodePoint]
+    RangeSet complement() const;
+
+    const std::vector<CodeRange>& ranges() const;
+
+    bool operator==(const RangeSet& other) const;
+
+    // Exemple : [a-z0-9] ; les points de code non imprimables sont écrits
+    // en hexadécimal
+    std::string to_string() const;
+
+private:
+    std::vector<CodeRange> intervals;
+};
+
+class RangeAutomaton {
+public:
+    struct Transition {
+        RangeSet label;
+        int dst;
+    };
+
+    RangeAutomaton() = default;
+
+    // Chaque octet c de aut devient le point de code (unsigned char) c ;
+    // les transitions parallèles entre deux mêmes états sont fusionnées
+    explicit RangeAutomaton(const Automaton& aut);
+
+    int size() const;
+    int newstate();
+
+    void add_init(int q);
+    void add_final(int q);
+
+    // Ajoute label à l'étiquette de la transition src -> dst, créée si besoin
+    void add_trans(int src, const RangeSet& label, int dst);
+    void add_trans(int src, char32_t lo, char32_t hi, int dst);
+
+    const std::vector<int>& get_inits() const;
+    bool is_final(int q) const;
+    const std::vector<Transition>& out(int q) const;
+
+    // Nombre de transitions (une par couple d'états relié)
+    size_t nb_transitions() const;
+
+    bool appartient(const std::u32string& word) const;
+
+    // Faux si word n'est pas de l'UTF-8 valide
+    bool appartientUtf8(const std::string& word) const;
+
+    // Les étiquettes comptent dans "labels", les listes de transitions
+    // elles-mêmes dans "transitions"
+    MemoryUsage memory_usage() const;
+
+    void print() const;
+
+private:
+    std::vector<int> inits;
+    std::vector<bool> finals;
+    std::vector<std::vector<Transition>> transitions;
+};
+
+// Décode le point de code UTF-8 commençant en s[pos] et avance pos.
+// Rejette les séquences tronquées, les formes non minimales, les
+// demi-codets et les valeurs au-delà de maxCodePoint.
+bool decodeUtf8(const std::string& s, size_t& pos, char32_t& c);
+
+// Les états du résultat sont numérotés dans l'ordre de leur découverte
+// (largeur d'abord), l'état initial est 0.
+RangeAutomaton determinize(const RangeAutomaton& aut);
+RangeAutomaton intersection(const RangeAutomaton& a, const RangeAutomaton& b);
+
+// Complémentaire par rapport à l'ensemble de tous les mots de points de code
+RangeAutomaton complement(const RangeAutomaton& aut);
+
+#endif // RANGEAUTOMATON_H
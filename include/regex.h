@@ -0,0 +1,30 @@
+/**
+ * @brief Compilation d'expressions régulières en automates de Glushkov
+ *
+ * Syntaxe reconnue :
+ *   e|f      union
+ *   ef       concaténation
+ *   e* e+ e? étoile, itération stricte, option
+ *   (e)      groupement, () désigne le mot vide
+ *   [abc]    classe de caractères, avec intervalles [a-z0-9]
+ *   [^abc]   classe complémentaire (parmi les caractères imprimables)
+ *   .        n'importe quel caractère imprimable (' ' à '~')
+ *   \c       le caractère c pris littéralement
+ *
+ * L'automate produit est sans epsilon-transition : l'état 0 est l'unique
+ * état initial et chaque occurrence de lettre (ou de classe) de l'expression
+ * donne exactement un état. Le nombre d'états est donc linéaire en la
+ * taille de l'expression.
+ */
+
+#ifndef REGEX_H
+#define REGEX_H
+
+#include <string>
+#include "automaton.h"
+
+// Construit l'automate de Glushkov de l'expression regex.
+// Lève std::invalid_argument si l'expression est mal formée.
+Automaton glushkov(const std::string& regex);
+
+#endif // REGEX_H
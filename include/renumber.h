@@ -0,0 +1,54 @@
+/**
+ * @brief Renumérotation des états pour la localité mémoire.
+ *
+ * Les numéros d'états viennent de l'ordre de création (newstate, ou
+ * addindex dans determinize et intersection), si bien que les états
+ * parcourus ensemble peuvent être dispersés dans une grande table de
+ * transitions. determinize numérote cependant les successeurs d'un état
+ * consécutivement et traite le dernier découvert en premier, ce qui est
+ * déjà proche d'un parcours en profondeur : sur un arbre préfixe, le gain
+ * mesuré par bench_renumber ne dépasse pas quelques pour cent.
+ * Les ordres calculés ici rapprochent les états visités ensemble : largeur
+ * d'abord (les états proches de l'initial en tête), profondeur d'abord
+ * (un chemin occupe des numéros consécutifs) ou fréquences de visite
+ * mesurées sur un échantillon d'entrées (les états chauds en tête).
+ *
+ * Un ordre est une permutation : order[i] est l'ancien numéro de l'état
+ * qui reçoit le numéro i. renumber() l'applique à un Automaton,
+ * DfaTable::renumber() à une table déjà compilée.
+ */
+
+#ifndef RENUMBER_H
+#define RENUMBER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "automaton.h"
+#include "dfatable.h"
+
+// Accessibles en largeur d'abord, lettres dans l'ordre croissant, puis les
+// états inaccessibles dans l'ordre de leurs numéros
+std::vector<int> bfsOrder(const Automaton& aut);
+
+// Idem en profondeur d'abord (ordre préfixe)
+std::vector<int> dfsOrder(const Automaton& aut);
+
+// Nombre de passages par chaque état de table en lisant les mots samples
+std::vector<uint64_t> visitCounts(const DfaTable& table, const std::vector<std::string>& samples);
+
+// États par classe de fréquence décroissante (compteurs regroupés par
+// puissance de deux) ; dans une même classe, les états gardent leur ordre
+// dans base (par défaut 0, 1, ..., n - 1). Avec base = dfsOrder(aut), les
+// chemins chauds restent sur des numéros voisins.
+std::vector<int> profileOrder(const std::vector<uint64_t>& counts,
+                              const std::vector<int>& base = std::vector<int>());
+
+// Permutation inverse : inverse[order[i]] == i. Lève std::invalid_argument
+// si order n'est pas une permutation de {0, ..., n - 1}.
+std::vector<int> inversePermutation(const std::vector<int>& order, int n);
+
+// Même langage ; les transitions sont rangées par nouvel état source
+Automaton renumber(const Automaton& aut, const std::vector<int>& order);
+
+#endif // RENUMBER_H
@@ -0,0 +1,79 @@
+/**
+ * @brief Recherche non ancrée : occurrences dans un texte des mots
+ * reconnus par un automate.
+ *
+ * Searcher déterminise l'automate une fois et l'exécute depuis chaque
+ * position de départ candidate. Un préfiltre calculé à partir de
+ * l'automate saute directement aux positions candidates :
+ *  - préfixe littéral commun à tous les mots reconnus : recherche de
+ *    sous-chaîne (memchr puis comparaison) ;
+ *  - un seul premier octet possible : memchr ;
+ *  - deux ou trois premiers octets : comparaison de 16 octets à la fois
+ *    (SSE2) ;
+ *  - sinon, table des premiers octets possibles.
+ * Si le mot vide est reconnu, toutes les positions sont candidates.
+ *
+ * Sémantiques :
+ *  - LeftmostLongest : départ le plus à gauche, puis fin la plus lointaine ;
+ *  - LeftmostFirst : départ le plus à gauche, puis première fin atteinte.
+ *    Un automate n'ordonne pas ses alternatives : c'est donc l'occurrence
+ *    la plus courte partant de la position la plus à gauche.
+ *
+ * Chaque départ candidat exécute l'automate jusqu'à ce qu'aucune
+ * occurrence ne puisse plus être prolongée : le pire cas est quadratique
+ * en la longueur du texte.
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "automaton.h"
+#include "dfatable.h"
+
+// Occurrence text[start .. end[
+struct Match {
+    size_t start;
+    size_t end;
+};
+
+enum class MatchSemantics { LeftmostLongest, LeftmostFirst };
+
+class Searcher {
+public:
+    explicit Searcher(const Automaton& aut,
+                      MatchSemantics semantics = MatchSemantics::LeftmostLongest);
+
+    // Première occurrence commençant en pos ou après
+    bool find(std::string_view text, size_t pos, Match& match) const;
+
+    // Occurrences successives sans chevauchement, de gauche à droite.
+    // Après une occurrence vide, la recherche reprend un octet plus loin.
+    std::vector<Match> findAll(std::string_view text) const;
+
+    // Description du préfiltre choisi, par exemple "litteral \"err\""
+    std::string prefilter() const;
+
+    MemoryUsage memory_usage() const;
+
+private:
+    enum PrefilterKind { All, Literal, OneByte, FewBytes, ByteSet };
+
+    DfaTable dfa;
+    MatchSemantics semantics;
+    PrefilterKind kind;
+    std::string literal;                // Préfixe commun (Literal)
+    std::vector<unsigned char> firsts;  // Premiers octets possibles
+    bool isFirst[256];
+
+    // Prochaine position >= pos où une occurrence peut commencer,
+    // std::string_view::npos s'il n'y en a pas
+    size_t candidate(std::string_view text, size_t pos) const;
+
+    // Fin de l'occurrence commençant en start, -1 s'il n'y en a pas
+    long long matchAt(std::string_view text, size_t start) const;
+};
+
+#endif // SEARCH_H
@@ -0,0 +1,279 @@
+/**
+ * @brief Reconnaissance bit-parallèle (Shift-And généralisé) pour les petits
+ * automates.
+ *
+ * Lorsque l'automate a au plus 64, 128 ou 256 états, l'ensemble des états
+ * courants tient dans 1, 2 ou 4 mots machine. Deux formes :
+ *  - automate homogène (on entre dans un état par les mêmes lettres quel
+ *    que soit l'état de départ, comme dans un automate de Glushkov) : les
+ *    successeurs par c sont les successeurs par n'importe quelle lettre,
+ *    filtrés par le masque des états où l'on entre par c. Les transitions p -> p + 1 (la
+ *    concaténation, numérotée de gauche à droite) se font par un décalage
+ *    d'un bit ; les autres passent par une table indépendante de la lettre,
+ *    limitée aux tranches de 8 états qui en ont (256 entrées par tranche).
+ *    Pour une recherche de mots-clés, une seule tranche : une lettre coûte
+ *    un décalage, un accès à la table et deux opérations logiques ;
+ *  - sinon, une table par lettre, par tranche de 4 états (16 entrées), dont
+ *    seules les tranches des états existants sont lues, les tranches de
+ *    poids fort vides de l'ensemble courant étant sautées.
+ */
+
+#ifndef SHIFTAND_H
+#define SHIFTAND_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "automaton.h"
+#include "memusage.h"
+
+template <int NW>
+class ShiftAndMatcher {
+public:
+    // Nombre maximal d'états pris en charge
+    static const int maxStates = 64 * NW;
+
+    // Lève std::invalid_argument si aut a plus de maxStates états.
+    explicit ShiftAndMatcher(const Automaton& aut)
+        : nb_letters(0), nb_words((aut.size() + 63) / 64), homogeneous_(true) {
+        if (aut.size() > maxStates) {
+            throw std::invalid_argument("ShiftAndMatcher : trop d'états ("
+                                        + std::to_string(aut.size()) + ")");
+        }
+        letterIndex.fill(-1);
+        std::vector<std::bitset<256>> entry(aut.size());   // Lettres entrant dans chaque état
+        std::map<std::pair<int, int>, std::bitset<256>> edges;
+        for (const auto& t : aut.get_trans()) {
+            unsigned char c = static_cast<unsigned char>(std::get<1>(t));
+            if (letterIndex[c] < 0) {
+                letterIndex[c] = nb_letters++;
+            }
+            entry[std::get<2>(t)].set(letterIndex[c]);
+            edges[{std::get<0>(t), std::get<2>(t)}].set(letterIndex[c]);
+        }
+        for (const auto& e : edges) {
+            homogeneous_ = homogeneous_ && e.second == entry[e.first.second];
+        }
+
+        if (homogeneous_) {
+            // Les transitions p -> p + 1 vont dans shiftable, les autres
+            // dans la table des exceptions
+            std::vector<Mask> succ(aut.size(), Mask{});
+            shiftable = Mask{};
+            for (const auto& t : aut.get_trans()) {
+                int p = std::get<0>(t);
+                int q = std::get<2>(t);
+                if (q == p + 1) {
+                    setBit(shiftable, p);
+                } else {
+                    setBit(succ[p], q);
+                }
+            }
+            std::vector<Mask> rows = buildTable(succ, 8);
+            for (int k = 0; k < nb_words * 8; ++k) {
+                bool used = false;
+                for (int q = 8 * k; q < 8 * k + 8 && q < aut.size(); ++q) {
+                    used = used || succ[q] != Mask{};
+                }
+                if (used) {
+                    exceptionChunks.push_back(k);
+                    follow.insert(follow.end(), rows.begin() + 256 * k,
+                                  rows.begin() + 256 * (k + 1));
+                }
+            }
+            letterMasks.assign(nb_letters, Mask{});
+            for (int q = 0; q < aut.size(); ++q) {
+                for (int l = 0; l < nb_letters; ++l) {
+                    if (entry[q].test(l)) {
+                        setBit(letterMasks[l], q);
+                    }
+                }
+            }
+        } else {
+            for (int l = 0; l < nb_letters; ++l) {
+                std::vector<Mask> succ(aut.size(), Mask{});
+                for (const auto& t : aut.get_trans()) {
+                    if (letterIndex[static_cast<unsigned char>(std::get<1>(t))] == l) {
+                        setBit(succ[std::get<0>(t)], std::get<2>(t));
+                    }
+                }
+                std::vector<Mask> rows = buildTable(succ, 4);
+                table.insert(table.end(), rows.begin(), rows.end());
+            }
+        }
+
+        inits = Mask{};
+        for (int q : aut.get_inits()) {
+            setBit(inits, q);
+        }
+        finals = Mask{};
+        for (int q : aut.get_finals()) {
+            setBit(finals, q);
+        }
+    }
+
+    // Successeurs indépendants de la lettre, filtrés par les masques de
+    // lettres (décalage et exceptions)
+    bool homogeneous() const {
+        return homogeneous_;
+    }
+
+    // Même résultat que appartient(aut, word)
+    bool appartient(const std::string& word) const {
+        return homogeneous_ ? run<true>(word) : run<false>(word);
+    }
+
+    // Tables lues : 256 masques par tranche de 8 états ayant des
+    // exceptions si l'automate est homogène, sinon 16 masques par tranche de
+    // 4 états et par lettre, soit jusqu'à 256 Kio (256 états) dans le
+    // premier cas et 8 Mio (256 états, 256 lettres) dans le second
+    MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        usage.add("letterIndex", sizeof(letterIndex), sizeof(letterIndex));
+        usage.add_vector("exceptionChunks", exceptionChunks);
+        usage.add_vector("follow", follow);
+        usage.add_vector("letterMasks", letterMasks);
+        usage.add_vector("table", table);
+        return usage;
+    }
+
+private:
+    typedef std::array<uint64_t, NW> Mask;
+
+    std::array<int, 256> letterIndex; // -1 si la lettre n'étiquette aucune transition
+    int nb_letters;
+    int nb_words;                     // Mots utiles : ceux des états existants
+    bool homogeneous_;
+    Mask inits;
+    Mask finals;
+    Mask shiftable;                   // Homogène : états p ayant la transition p -> p + 1
+    std::vector<unsigned> exceptionChunks; // Homogène : tranches de 8 ayant d'autres transitions
+    std::vector<Mask> follow;         // ... et leurs successeurs : [tranche][256 sous-ensembles]
+    std::vector<Mask> letterMasks;    // Homogène : états où l'on entre par la lettre
+    std::vector<Mask> table;          // Sinon : [lettre][tranche de 4][16 sous-ensembles]
+
+    static void setBit(Mask& m, int q) {
+        m[q / 64] |= uint64_t(1) << (q % 64);
+    }
+
+    // Pour chaque tranche de bits états des nb_words premiers mots,
+    // l'union des successeurs de chaque sous-ensemble de la tranche :
+    // row[v] = row[v sans son bit de poids faible] | succ(ce bit)
+    std::vector<Mask> buildTable(const std::vector<Mask>& succ, int bits) const {
+        int size = 1 << bits;
+        int chunks = nb_words * 64 / bits;
+        std::vector<Mask> rows(static_cast<size_t>(chunks) * size, Mask{});
+        for (int k = 0; k < chunks; ++k) {
+            Mask* row = &rows[static_cast<size_t>(k) * size];
+            for (int v = 1; v < size; ++v) {
+                int q = bits * k + __builtin_ctz(static_cast<unsigned>(v));
+                const Mask& s = q < static_cast<int>(succ.size()) ? succ[q] : Mask{};
+                for (int w = 0; w < NW; ++w) {
+                    row[v][w] = row[v & (v - 1)][w] | s[w];
+                }
+            }
+        }
+        return rows;
+    }
+
+    // Corps de appartient, la forme des tables étant fixée à la compilation
+    template <bool HOMOGENEOUS>
+    bool run(const std::string& word) const {
+        Mask current = inits;
+        size_t rowsPerLetter = static_cast<size_t>(nb_words) * (64 / 4) * 16;
+        for (char c : word) {
+            int l = letterIndex[static_cast<unsigned char>(c)];
+            if (l < 0) {
+                return false;
+            }
+            Mask next{};
+            uint64_t any = 0;
+            if (HOMOGENEOUS) {
+                const Mask* rows = follow.data();
+                for (unsigned k : exceptionChunks) {
+                    const Mask& m = rows[current[k / 8] >> (8 * (k % 8)) & 0xff];
+                    for (int w = 0; w < NW; ++w) {
+                        next[w] |= m[w];
+                    }
+                    rows += 256;
+                }
+                // Décalage d'un bit, retenue comprise, puis filtre par la lettre
+                const Mask& entering = letterMasks[l];
+                uint64_t carry = 0;
+                for (int w = 0; w < NW; ++w) {
+                    uint64_t moved = current[w] & shiftable[w];
+                    next[w] = (next[w] | moved << 1 | carry) & entering[w];
+                    carry = moved >> 63;
+                    any |= next[w];
+                }
+            } else {
+                union_of(current, &table[l * rowsPerLetter], next);
+                for (int w = 0; w < NW; ++w) {
+                    any |= next[w];
+                }
+            }
+            if (any == 0) {
+                return false;
+            }
+            current = next;
+        }
+        for (int w = 0; w < NW; ++w) {
+            if (current[w] & finals[w]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // next |= successeurs de current, tranche de 4 états par tranche ;
+    // le parcours d'un mot s'arrête à sa dernière tranche non vide
+    void union_of(const Mask& current, const Mask* rows, Mask& next) const {
+        for (int w = 0; w < nb_words; ++w) {
+            uint64_t bits = current[w];
+            const Mask* r = rows + (static_cast<size_t>(w) * 16 << 4);
+            for (; bits != 0; bits >>= 4, r += 16) {
+                const Mask& m = r[bits & 0xf];
+                for (int x = 0; x < NW; ++x) {
+                    next[x] |= m[x];
+                }
+            }
+        }
+    }
+};
+
+// Choisit automatiquement le moteur le plus adapté à la taille de
+// l'automate : Shift-And sur 64, 128 ou 256 bits, sinon simulation par
+// appartient() sur une copie de l'automate.
+class Matcher {
+public:
+    explicit Matcher(const Automaton& aut);
+
+    bool appartient(const std::string& word) const;
+
+    // Nombre de bits du moteur bit-parallèle utilisé, 0 pour appartient()
+    int width() const;
+
+    // Moteur bit-parallèle à décalage (voir ShiftAndMatcher)
+    bool homogeneous() const;
+
+    // Celle du moteur choisi
+    MemoryUsage memory_usage() const;
+
+private:
+    typedef std::variant<Automaton, ShiftAndMatcher<1>, ShiftAndMatcher<2>, ShiftAndMatcher<4>>
+        Engine;
+
+    Engine engine;
+
+    // Construit directement le moteur choisi, sans copie de l'automate
+    // s'il est bit-parallèle
+    static Engine makeEngine(const Automaton& aut);
+};
+
+#endif // SHIFTAND_H
@@ -0,0 +1,41 @@
+/**
+ * @brief Extraction de mots reconnus par un automate : plus court témoin,
+ * énumération bornée et dénombrement par longueur.
+ *
+ * Les trois fonctions travaillent sur l'index d'adjacence (Adjacency) et
+ * coûtent un temps linéaire en la taille de l'automate par longueur de mot
+ * considérée, sauf countWords sur un automate non déterministe (voir
+ * plus bas).
+ */
+
+#ifndef WORDS_H
+#define WORDS_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "automaton.h"
+
+// Calcule dans word un plus court mot reconnu par aut (parcours en largeur).
+// Retourne false, sans modifier word, si le langage est vide.
+bool shortestWord(const Automaton& aut, std::string& word);
+
+// Appelle f sur chaque mot reconnu de longueur au plus maxLength, sans
+// doublon, dans l'ordre hiérarchique : par longueur croissante puis par
+// ordre lexicographique (celui de std::string). Les mots sont produits au
+// fur et à mesure ; l'énumération s'arrête dès que f retourne false.
+void enumerateWords(const Automaton& aut, size_t maxLength,
+                    const std::function<bool(const std::string&)>& f);
+
+// counts[l] = nombre de mots de longueur l reconnus par aut, pour l de 0 à
+// maxLength, modulo modulus (modulus = 0 : modulo 2^64). Pour compter des
+// mots et non des chemins, un automate non déterministe est déterminisé à
+// la demande (lazyDeterminize), limité aux ensembles d'états atteints en au
+// plus maxLength lettres depuis l'état initial. Ce nombre d'ensembles peut
+// rester exponentiel en le nombre d'états : au-delà de la mémoire
+// disponible, compter sur le résultat de determinize avec budget
+// (extdeterminize.h).
+std::vector<uint64_t> countWords(const Automaton& aut, size_t maxLength, uint64_t modulus = 0);
+
+#endif // WORDS_H
@@ -0,0 +1,115 @@
+#include "adjacency.h"
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+namespace {
+
+bool edgeLess(const Adjacency::Edge& a, const Adjacency::Edge& b) {
+    if (a.letter != b.letter) {
+        return a.letter < b.letter;
+    }
+    return a.state < b.state;
+}
+
+// Répartit les transitions par état (tri par comptage), puis trie la liste
+// de chaque état. From/To désignent les composantes du tuple prises comme
+// origine et extrémité de la liste.
+template <int From, int To>
+void buildIndex(const Automaton& aut, vector<int>& offsets, vector<Adjacency::Edge>& edges) {
+    int n = aut.size();
+    offsets.assign(n + 1, 0);
+    for (const auto& t : aut.get_trans()) {
+        ++offsets[get<From>(t) + 1];
+    }
+    for (int q = 0; q < n; ++q) {
+        offsets[q + 1] += offsets[q];
+    }
+    edges.resize(aut.get_trans().size());
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& t : aut.get_trans()) {
+        edges[fill[get<From>(t)]++] = {get<1>(t), get<To>(t)};
+    }
+    for (int q = 0; q < n; ++q) {
+        sort(edges.begin() + offsets[q], edges.begin() + offsets[q + 1], edgeLess);
+    }
+}
+
+// Parcours en largeur, chaque état n'étant visité qu'une fois grâce au
+// marquage dense.
+template <typename Begin, typename End>
+vector<bool> reach(int n, const IdxSet<int>& srcs, Begin begin, End end) {
+    vector<bool> visited(n, false);
+    vector<int> queue;
+    queue.reserve(n);
+    for (int q : srcs) {
+        if (q < n && !visited[q]) {
+            visited[q] = true;
+            queue.push_back(q);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int q = queue[head];
+        for (const Adjacency::Edge* e = begin(q); e != end(q); ++e) {
+            if (!visited[e->state]) {
+                visited[e->state] = true;
+                queue.push_back(e->state);
+            }
+        }
+    }
+    return visited;
+}
+
+} // namespace
+
+Adjacency::Adjacency(const Automaton& aut) {
+    buildIndex<0, 2>(aut, out_offsets, out_edges);
+    buildIndex<2, 0>(aut, in_offsets, in_edges);
+}
+
+int Adjacency::size() const {
+    return static_cast<int>(out_offsets.size()) - 1;
+}
+
+const Adjacency::Edge* Adjacency::out_begin(int q) const {
+    return out_edges.data() + out_offsets[q];
+}
+
+const Adjacency::Edge* Adjacency::out_end(int q) const {
+    return out_edges.data() + out_offsets[q + 1];
+}
+
+const Adjacency::Edge* Adjacency::in_begin(int q) const {
+    return in_edges.data() + in_offsets[q];
+}
+
+const Adjacency::Edge* Adjacency::in_end(int q) const {
+    return in_edges.data() + in_offsets[q + 1];
+}
+
+pair<const Adjacency::Edge*, const Adjacency::Edge*> Adjacency::out(int q, char c) const {
+    auto byLetter = [](const Edge& a, const Edge& b) { return a.letter < b.letter; };
+    return equal_range(out_begin(q), out_end(q), Edge{c, 0}, byLetter);
+}
+
+MemoryUsage Adjacency::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("out_offsets", out_offsets);
+    usage.add_vector("out_edges", out_edges);
+    usage.add_vector("in_offsets", in_offsets);
+    usage.add_vector("in_edges", in_edges);
+    return usage;
+}
+
+vector<bool> forwardReach(const Adjacency& adj, const IdxSet<int>& srcs) {
+    return reach(adj.size(), srcs,
+                 [&adj](int q) { return adj.out_begin(q); },
+                 [&adj](int q) { return adj.out_end(q); });
+}
+
+vector<bool> backwardReach(const Adjacency& adj, const IdxSet<int>& srcs) {
+    return reach(adj.size(), srcs,
+                 [&adj](int q) { return adj.in_begin(q); },
+                 [&adj](int q) { return adj.in_end(q); });
+}
@@ -62,6 +62,14 @@ void Automaton::add_final(const vector<int>& states) {
     }
 }
 
+// Ajoute un état final sans tester s'il l'est déjà
+void Automaton::add_final_unchecked(int e) {
+    finals.add_unchecked(e);
+    if (e >= nb_states) {
+        nb_states = e + 1;
+    }
+}
+
 // Vérifie si un état est final
 bool Automaton::is_final(int q) const {
     return finals.mem(q);
@@ -129,6 +137,19 @@ void Automaton::add_trans(int src, const IdxSet<char> letters, int dst) {
     }
 }
 
+// Ajoute une transition sans vérifier qu'elle est nouvelle
+void Automaton::add_trans_unchecked(int src, char c, int dst) {
+    transitions.add_unchecked({src, c, dst});
+
+    if (src >= nb_states) {
+        nb_states = src + 1;
+    }
+    if (dst >= nb_states) {
+        nb_states = dst + 1;
+    }
+    add_letter(c);
+}
+
 const IdxSet<int>& Automaton::get_finals() const {
     return finals;
 }
@@ -171,6 +192,17 @@ IdxSet<int> Automaton::in_states(char c, int q) const {
     return result;
 }
 //===============================================
+
+// Mémoire occupée, ensemble par ensemble
+MemoryUsage Automaton::memory_usage() const {
+    MemoryUsage usage;
+    usage.add("inits", inits.memory_usage());
+    usage.add("alphabet", alphabet.memory_usage());
+    usage.add("transitions", transitions.memory_usage());
+    usage.add("finals", finals.memory_usage());
+    return usage;
+}
+
 // Fonctions d'affichage
 void Automaton::print() const {
     cout << "Number of states: " << nb_states << endl;
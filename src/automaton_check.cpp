@@ -0,0 +1,920 @@
+// Banc de non-régression différentiel :
+//   automaton_check [--seed N] [--iterations N] [--baseline fichier]
+//                   [--threshold R] [--update]
+//
+// Les implémentations directes de operations.cpp (celles d'origine de
+// mainwindow.cpp) servent de référence. Sur des automates et des mots
+// tirés au hasard (graine fixe), chaque moteur optimisé est comparé à la
+// référence par équivalence de langages et par appartenance de mots.
+// equivalent lui-même est comparé à un parcours des paires d'ensembles
+// d'états, glushkov à std::regex, shortestWord et enumerateWords à tous
+// les mots courts, GraphModel, layoutNeighbourhood et writeDot aux
+// transitions de l'automate affiché.
+//
+// Le temps passé dans chaque moteur optimisé est comparé au fichier de
+// référence des temps (par défaut automaton_check_baseline.txt, une ligne
+// "<vérification> <secondes>" chacune) : un temps dépassant threshold fois
+// (1.25 par défaut) celui de la référence est signalé. --update réécrit ce
+// fichier avec les temps mesurés. Les temps dépendent de la machine : le
+// fichier n'est pas versionné.
+//
+// Code de retour : 0 si tout concorde sans ralentissement, 1 sinon.
+
+#include "dfatable.h"
+#include "equivalence.h"
+#include "extdeterminize.h"
+#include "frozen.h"
+#include "graphmodel.h"
+#include "hybriddfa.h"
+#include "incremental.h"
+#include "lazy.h"
+#include "opcache.h"
+#include "operations.h"
+#include "parallelgraph.h"
+#include "product.h"
+#include "rangeautomaton.h"
+#include "regex.h"
+#include "search.h"
+#include "shiftand.h"
+#include "words.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const string letters = "abc";
+
+struct Result {
+    string name;
+    size_t cases = 0;
+    size_t failures = 0;
+    double seconds = 0;     // Temps passé dans les moteurs optimisés
+    string firstFailure;
+};
+
+// Mesure le temps de f et l'ajoute à result
+template <typename F>
+auto timed(Result& result, F f) -> decltype(f()) {
+    auto start = chrono::steady_clock::now();
+    auto value = f();
+    result.seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return value;
+}
+
+void check(Result& result, bool ok, const string& what) {
+    ++result.cases;
+    if (!ok) {
+        if (result.failures == 0) {
+            result.firstFailure = what;
+        }
+        ++result.failures;
+    }
+}
+
+Automaton randomAutomaton(mt19937& rng, int maxStates) {
+    Automaton aut;
+    int n = 1 + rng() % maxStates;
+    for (int i = 0; i < n; ++i) {
+        aut.newstate();
+    }
+    for (int i = 0, m = n * (1 + rng() % 3); i < m; ++i) {
+        aut.add_trans(rng() % n, letters[rng() % letters.size()], rng() % n);
+    }
+    for (int i = 0, k = 1 + rng() % 2; i < k; ++i) {
+        aut.add_init(rng() % n);
+    }
+    for (int i = 0, k = rng() % 3; i < k; ++i) {
+        aut.add_final(rng() % n);
+    }
+    return aut;
+}
+
+vector<string> randomWords(mt19937& rng, size_t count, size_t maxLength) {
+    vector<string> words;
+    for (size_t i = 0; i < count; ++i) {
+        string w;
+        for (size_t k = 0, n = rng() % (maxLength + 1); k < n; ++k) {
+            w += letters[rng() % letters.size()];
+        }
+        words.push_back(w);
+    }
+    return words;
+}
+
+// trim d'origine : états utiles gardés avec leurs numéros
+Automaton referenceTrim(const Automaton& aut) {
+    IdxSet<int> accessible = succesorsStar(aut, aut.get_inits());
+    IdxSet<int> coaccessible = predecessorsStar(aut, aut.get_finals());
+    Automaton result;
+    for (int s : accessible) {
+        if (coaccessible.mem(s)) {
+            if (aut.get_inits().mem(s)) {
+                result.add_init(s);
+            }
+            if (aut.get_finals().mem(s)) {
+                result.add_final(s);
+            }
+        }
+    }
+    for (const auto& t : aut.get_trans()) {
+        int src = get<0>(t);
+        int dst = get<2>(t);
+        if (accessible.mem(src) && coaccessible.mem(src) && accessible.mem(dst)
+            && coaccessible.mem(dst)) {
+            result.add_trans(src, get<1>(t), dst);
+        }
+    }
+    return result;
+}
+
+// Nombre d'états utiles de referenceTrim (les autres numéros sont des trous)
+int usefulStates(const Automaton& aut) {
+    IdxSet<int> accessible = succesorsStar(aut, aut.get_inits());
+    IdxSet<int> coaccessible = predecessorsStar(aut, aut.get_finals());
+    int n = 0;
+    for (int s : accessible) {
+        n += coaccessible.mem(s) ? 1 : 0;
+    }
+    return n;
+}
+
+u32string toCodePoints(const string& w) {
+    return u32string(w.begin(), w.end());
+}
+
+// Équivalence de référence, avec les fonctions d'origine : parcours des
+// paires (ensemble d'états de a, ensemble d'états de b) atteintes par un
+// même mot. La différence symétrique est vide si et seulement si aucune
+// paire atteinte n'a exactement un ensemble contenant un état final.
+bool referenceEquivalent(const Automaton& a, const Automaton& b) {
+    using Pair = pair<vector<int>, vector<int>>;
+    auto final = [](const Automaton& aut, const vector<int>& states) {
+        for (int q : states) {
+            if (aut.get_finals().mem(q)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto step = [](const Automaton& aut, const vector<int>& states, char c) {
+        IdxSet<int> next;
+        for (int q : states) {
+            next.add(aut.out_states(q, c));
+        }
+        vector<int> result(next.begin(), next.end());
+        sort(result.begin(), result.end());
+        return result;
+    };
+    IdxSet<char> alphabet = a.get_alphabet();
+    alphabet.add(b.get_alphabet());
+
+    Pair start(vector<int>(a.get_inits().begin(), a.get_inits().end()),
+               vector<int>(b.get_inits().begin(), b.get_inits().end()));
+    sort(start.first.begin(), start.first.end());
+    sort(start.second.begin(), start.second.end());
+    set<Pair> seen = {start};
+    vector<Pair> todo = {start};
+    while (!todo.empty()) {
+        Pair p = todo.back();
+        todo.pop_back();
+        if (final(a, p.first) != final(b, p.second)) {
+            return false;
+        }
+        for (char c : alphabet) {
+            Pair next(step(a, p.first, c), step(b, p.second, c));
+            if (seen.insert(next).second) {
+                todo.push_back(next);
+            }
+        }
+    }
+    return true;
+}
+
+// Tous les mots sur letters de longueur au plus maxLength, par longueur
+// croissante puis dans l'ordre lexicographique
+vector<string> allWords(size_t maxLength) {
+    vector<string> words = {""};
+    for (size_t begin = 0, length = 0; length < maxLength; ++length) {
+        size_t end = words.size();
+        for (size_t i = begin; i < end; ++i) {
+            for (char c : letters) {
+                words.push_back(words[i] + c);
+            }
+        }
+        begin = end;
+    }
+    return words;
+}
+
+// Expression régulière aléatoire sur letters, dans la syntaxe commune à
+// glushkov et à std::regex ; positions compte les occurrences de lettres
+// et de classes, qui donnent chacune un état de l'automate de Glushkov
+string randomRegex(mt19937& rng, int depth, int& positions) {
+    static const vector<string> classes = {".", "[ab]", "[^a]", "[a-c]"};
+    int kind = depth == 0 ? 3 + rng() % 3 : rng() % 6;
+    switch (kind) {
+    case 0:
+        return randomRegex(rng, depth - 1, positions) + "|" + randomRegex(rng, depth - 1, positions);
+    case 1:
+        return randomRegex(rng, depth - 1, positions) + randomRegex(rng, depth - 1, positions);
+    case 2:
+        return "(" + randomRegex(rng, depth - 1, positions) + ")" + "*+?"[rng() % 3];
+    case 3:
+        ++positions;
+        return string(1, letters[rng() % letters.size()]) + (rng() % 2 ? "*" : "");
+    case 4:
+        ++positions;
+        return classes[rng() % classes.size()];
+    default:
+        return rng() % 4 ? "(" + randomRegex(rng, max(depth - 1, 0), positions) + ")"
+                         : "()";
+    }
+}
+
+class Harness {
+public:
+    Harness(unsigned seed, int iterations) : seed(seed), iterations(iterations) {}
+
+    void run(const string& name, const function<void(Result&, mt19937&)>& body) {
+        Result result;
+        result.name = name;
+        mt19937 rng(seed);
+        for (int i = 0; i < iterations; ++i) {
+            body(result, rng);
+        }
+        results.push_back(result);
+    }
+
+    const vector<Result>& get_results() const {
+        return results;
+    }
+
+private:
+    unsigned seed;
+    int iterations;
+    vector<Result> results;
+};
+
+void membership(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 10);
+    vector<string> words = randomWords(rng, 40, 10);
+    Matcher matcher(aut);
+    Automaton det = determinize(aut);
+    DfaTable table(det);
+    HybridDfa hybrid(det);
+    HybridDfa hybridSparse(det, 0);
+    auto frozen = freeze(aut);
+    RangeAutomaton ranges(aut);
+    LazyAutomaton lazyAut = lazy(aut);
+    IncrementalDeterminizer incremental(aut);
+    Searcher searcher(aut);
+    for (const string& w : words) {
+        bool expected = appartient(aut, w);
+        check(r, timed(r, [&] { return matcher.appartient(w); }) == expected, "Matcher \"" + w + "\"");
+        check(r, timed(r, [&] { return table.appartient(w); }) == expected, "DfaTable \"" + w + "\"");
+        check(r, timed(r, [&] { return hybrid.appartient(w); }) == expected, "HybridDfa \"" + w + "\"");
+        check(r, timed(r, [&] { return hybridSparse.appartient(w); }) == expected,
+              "HybridDfa sans lignes denses \"" + w + "\"");
+        check(r, timed(r, [&] { return frozen->appartient(w); }) == expected, "FrozenAutomaton \"" + w + "\"");
+        check(r, timed(r, [&] { return ranges.appartient(toCodePoints(w)); }) == expected,
+              "RangeAutomaton \"" + w + "\"");
+        check(r, timed(r, [&] { return appartient(lazyAut, w); }) == expected, "lazy \"" + w + "\"");
+        check(r, timed(r, [&] { return incremental.appartient(w); }) == expected,
+              "IncrementalDeterminizer \"" + w + "\"");
+        bool whole = timed(r, [&] {
+            Match m;
+            return searcher.find(w, 0, m) && m.start == 0 && m.end == w.size();
+        });
+        check(r, whole == expected, "Searcher \"" + w + "\"");
+    }
+}
+
+void determinization(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 8);
+    Automaton expected = determinize(aut);
+
+    DeterminizeBudget budget;
+    DeterminizeReport report;
+    Automaton external = timed(r, [&] { return determinize(aut, budget, report); });
+    check(r, external.size() == expected.size() && equivalent(external, expected),
+          "determinize avec budget");
+
+    Automaton incremental = timed(r, [&] { return IncrementalDeterminizer(aut).dfa(); });
+    check(r, incremental.size() == expected.size() && equivalent(incremental, expected),
+          "IncrementalDeterminizer::dfa");
+
+    Automaton lazyDet = timed(r, [&] { return materialize(lazyDeterminize(lazy(aut))); });
+    check(r, lazyDet.size() == expected.size() && equivalent(lazyDet, expected),
+          "lazyDeterminize");
+
+    RangeAutomaton rangeDet = timed(r, [&] { return determinize(RangeAutomaton(aut)); });
+    bool same = rangeDet.size() == expected.size();
+    for (const string& w : randomWords(rng, 20, 8)) {
+        same = same && rangeDet.appartient(toCodePoints(w)) == appartient(expected, w);
+    }
+    check(r, same, "determinize(RangeAutomaton)");
+}
+
+void intersections(Result& r, mt19937& rng) {
+    Automaton a = randomAutomaton(rng, 6);
+    Automaton b = randomAutomaton(rng, 6);
+    Automaton expected = intersection(a, b);
+
+    Automaton product = timed(r, [&] { return intersection(vector<Automaton>{a, b}, 1); });
+    check(r, equivalent(product, expected), "intersection n-aire");
+
+    Automaton lazyProduct = timed(r, [&] { return materialize(lazyIntersection(lazy(a), lazy(b))); });
+    check(r, equivalent(lazyProduct, expected), "lazyIntersection");
+
+    RangeAutomaton rangeProduct = timed(r, [&] { return intersection(RangeAutomaton(a), RangeAutomaton(b)); });
+    bool same = true;
+    for (const string& w : randomWords(rng, 30, 8)) {
+        same = same && rangeProduct.appartient(toCodePoints(w)) == appartient(expected, w);
+    }
+    check(r, same, "intersection(RangeAutomaton)");
+}
+
+void trimming(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 12);
+    Automaton expected = referenceTrim(aut);
+    Automaton trimmed = timed(r, [&] { return trim(aut); });
+    check(r, trimmed.size() == usefulStates(aut) && equivalent(trimmed, expected), "trim");
+    vector<int> old2new;
+    Automaton parallel = timed(r, [&] { return parallelTrim(aut, old2new, 4); });
+    check(r, parallel.size() == usefulStates(aut) && equivalent(parallel, expected), "parallelTrim");
+    check(r, timed(r, [&] { return parallelEmptyLanguage(aut, 4); }) == emptyLanguage(aut),
+          "parallelEmptyLanguage");
+}
+
+void components(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 12);
+    Adjacency adj(aut);
+    SccDecomposition scc = timed(r, [&] { return parallelScc(adj, 4); });
+
+    // Seuils minimaux : même sur ces petits graphes, parcours par niveaux
+    // répartis entre les threads, élagage et découpes FW-BW parallèles
+    ParallelOptions options;
+    options.nb_threads = 4;
+    options.min_parallel_frontier = 1;
+    options.min_parallel_states = 1;
+    options.max_tarjan_part = 1;
+    SccDecomposition fine = timed(r, [&] { return parallelScc(adj, options); });
+    SccDecomposition tarjan = timed(r, [&] { return tarjanScc(adj); });
+    check(r, fine.component == scc.component && fine.sizes == scc.sizes, "parallelScc, seuils minimaux");
+    check(r, tarjan.component == scc.component && tarjan.sizes == scc.sizes, "tarjanScc");
+    check(r, timed(r, [&] { return parallelForwardReach(adj, aut.get_inits(), options); })
+                 == forwardReach(adj, aut.get_inits()),
+          "parallelForwardReach, seuils minimaux");
+    check(r, timed(r, [&] { return parallelBackwardReach(adj, aut.get_finals(), options); })
+                 == backwardReach(adj, aut.get_finals()),
+          "parallelBackwardReach, seuils minimaux");
+
+    // Deux états sont dans la même composante s'ils sont accessibles l'un
+    // depuis l'autre
+    vector<IdxSet<int>> reachable;
+    for (int q = 0; q < aut.size(); ++q) {
+        IdxSet<int> src;
+        src.add(q);
+        reachable.push_back(succesorsStar(aut, src));
+    }
+    bool same = scc.component.size() == static_cast<size_t>(aut.size());
+    for (int p = 0; same && p < aut.size(); ++p) {
+        for (int q = 0; q < aut.size(); ++q) {
+            bool together = reachable[p].mem(q) && reachable[q].mem(p);
+            same = same && together == (scc.component[p] == scc.component[q]);
+        }
+    }
+    check(r, same, "parallelScc");
+
+    // Langage infini si et seulement s'il contient un mot de longueur
+    // comprise entre n et 2n - 1, n étant le nombre d'états du déterminisé
+    size_t n = static_cast<size_t>(determinize(aut).size());
+    vector<uint64_t> counts = countWords(aut, 2 * n);
+    bool infinite = false;
+    for (size_t l = n; l < counts.size(); ++l) {
+        infinite = infinite || counts[l] != 0;
+    }
+    check(r, timed(r, [&] { return infiniteLanguage(aut, 4); }) == infinite, "infiniteLanguage");
+}
+
+void complementation(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 8);
+    Automaton expected = complement(aut);
+
+    Automaton incremental = timed(r, [&] { return IncrementalDeterminizer(aut).complement(); });
+    check(r, equivalent(incremental, expected), "IncrementalDeterminizer::complement");
+
+    // lazyComplement complète sur l'alphabet de l'automate, complement sur
+    // celui du déterminisé : on ne compare que sur les lettres communes
+    Automaton det = determinize(aut);
+    const IdxSet<char>& alphabet = det.get_alphabet();
+    LazyAutomaton lazyComp = timed(r, [&] { return lazyComplement(lazy(aut)); });
+    bool same = true;
+    for (const string& w : randomWords(rng, 30, 8)) {
+        bool inAlphabet = true;
+        for (char c : w) {
+            inAlphabet = inAlphabet && alphabet.mem(c);
+        }
+        if (inAlphabet) {
+            same = same && timed(r, [&] { return appartient(lazyComp, w); }) == appartient(expected, w);
+        }
+    }
+    check(r, same, "lazyComplement");
+}
+
+void caching(Result& r, mt19937& rng) {
+    Automaton a = randomAutomaton(rng, 8);
+    Automaton b = randomAutomaton(rng, 8);
+
+    // Mêmes transitions dans l'ordre inverse : même empreinte
+    Automaton reversed;
+    for (int q = 0; q < a.size(); ++q) {
+        reversed.newstate();
+    }
+    for (int q : a.get_inits()) {
+        reversed.add_init(q);
+    }
+    for (int q : a.get_finals()) {
+        reversed.add_final(q);
+    }
+    for (auto it = a.get_trans().end(); it != a.get_trans().begin();) {
+        --it;
+        reversed.add_trans(get<0>(*it), get<1>(*it), get<2>(*it));
+    }
+    check(r, structuralHash(reversed) == structuralHash(a), "structuralHash et ordre d'insertion");
+
+    filesystem::path directory = filesystem::temp_directory_path()
+                                 / ("automaton_check_cache_" + to_string(rng()));
+    {
+        OpCache cache(2, directory.string());
+        shared_ptr<const Automaton> first = timed(r, [&] { return cache.determinize(a); });
+        shared_ptr<const Automaton> again = timed(r, [&] { return cache.determinize(reversed); });
+        check(r, cache.misses() == 1 && cache.hits() == 1, "OpCache : calcul puis succes");
+        check(r, equivalent(*first, determinize(a)) && again == first, "OpCache::determinize");
+        AutomatonHash hashA = structuralHash(a);
+        check(r, timed(r, [&] { return cache.determinize(a, hashA); }) == first,
+              "OpCache : empreinte fournie, resultat partage");
+
+        // Capacité 2 : le déterminisé de a, le plus ancien, est évincé
+        timed(r, [&] { return cache.complement(a, hashA); });
+        timed(r, [&] { return cache.intersection(a, b); });
+        check(r, cache.size() == 2 && cache.misses() == 3, "OpCache : eviction");
+        shared_ptr<const Automaton> reloaded = timed(r, [&] { return cache.determinize(a); });
+        check(r, cache.hits() == 3 && cache.misses() == 3 && equivalent(*reloaded, *first),
+              "OpCache : relecture apres eviction");
+    }
+    {
+        // Nouveau cache, mémoire vide : tout est relu depuis le répertoire
+        OpCache cache(4, directory.string());
+        shared_ptr<const Automaton> product = timed(r, [&] { return cache.intersection(a, b); });
+        shared_ptr<const Automaton> comp = timed(r, [&] { return cache.complement(a); });
+        check(r, cache.hits() == 2 && cache.misses() == 0
+                     && equivalent(*product, intersection(a, b)) && equivalent(*comp, complement(a)),
+              "OpCache : relecture depuis le disque");
+        timed(r, [&] { return cache.trim(b); });
+        check(r, cache.misses() == 1, "OpCache : absent du disque");
+    }
+    filesystem::remove_all(directory);
+}
+
+void equivalences(Result& r, mt19937& rng) {
+    Automaton a = randomAutomaton(rng, 6);
+    Automaton b;
+    switch (rng() % 4) {
+    case 0:
+        b = determinize(a);
+        break;
+    case 1:
+        b = trim(a);
+        break;
+    case 2:
+        b = randomAutomaton(rng, 6);
+        break;
+    default:
+        // Une transition de plus : le langage change ou non
+        b = a;
+        b.add_trans(rng() % a.size(), letters[rng() % letters.size()], rng() % a.size());
+        break;
+    }
+    string witness;
+    bool same = timed(r, [&] { return equivalent(a, b, &witness); });
+    check(r, same == referenceEquivalent(a, b), "equivalent");
+    if (!same) {
+        check(r, appartient(a, witness) != appartient(b, witness),
+              "temoin de equivalent \"" + witness + "\"");
+    }
+}
+
+void spilling(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 8);
+    Automaton expected = determinize(aut);
+
+    // Budget d'un octet : débordement dès le premier sous-ensemble exploré
+    // s'il en reste d'autres, et passes de fusion d'un enregistrement
+    DeterminizeBudget budget;
+    budget.memory_bytes = 1;
+    DeterminizeReport report;
+    Automaton external = timed(r, [&] { return determinize(aut, budget, report); });
+    check(r, report.status == DeterminizeReport::Complete && report.spilled == (expected.size() > 1),
+          "determinize, debordement sur disque : " + report.summary());
+    check(r, external.size() == expected.size() && equivalent(external, expected),
+          "determinize apres debordement");
+}
+
+void mutations(Result& r, mt19937& rng) {
+    IncrementalDeterminizer incremental(randomAutomaton(rng, 5));
+    for (int step = 1; step <= 30; ++step) {
+        int n = incremental.nfa().size();
+        int kind = rng() % 10;
+        timed(r, [&] {
+            if (kind == 0) {
+                incremental.newstate();
+            } else if (kind == 1) {
+                incremental.add_final(rng() % n);
+            } else if (kind == 2) {
+                incremental.add_init(rng() % n);
+            } else {
+                incremental.add_trans(rng() % n, letters[rng() % letters.size()], rng() % n);
+            }
+            return 0;
+        });
+        if (step % 10 == 0) {
+            Automaton nfa = incremental.nfa();
+            Automaton expected = determinize(nfa);
+            Automaton dfa = timed(r, [&] { return incremental.dfa(); });
+            check(r, dfa.size() == expected.size() && equivalent(dfa, expected),
+                  "IncrementalDeterminizer::dfa apres mutations");
+            Automaton comp = timed(r, [&] { return incremental.complement(); });
+            check(r, equivalent(comp, complement(nfa)), "IncrementalDeterminizer::complement apres mutations");
+            bool same = true;
+            for (const string& w : randomWords(rng, 20, 8)) {
+                same = same && timed(r, [&] { return incremental.appartient(w); }) == appartient(nfa, w);
+            }
+            check(r, same, "IncrementalDeterminizer::appartient apres mutations");
+        }
+    }
+
+    // Recherche de mots : l'état 0 boucle sur toutes les lettres, donc
+    // chaque mot ajouté redirige tous les sous-ensembles et en abandonne
+    // autant, assez pour déclencher des nettoyages
+    IncrementalDeterminizer search;
+    search.add_init(search.newstate());
+    for (char c : letters) {
+        search.add_trans(0, c, 0);
+    }
+    for (const string& w : randomWords(rng, 40, 8)) {
+        int q = 0;
+        timed(r, [&] {
+            for (char c : w) {
+                int next = search.newstate();
+                search.add_trans(q, c, next);
+                q = next;
+            }
+            search.add_final(q);
+            return 0;
+        });
+    }
+    Automaton expected = determinize(search.nfa());
+    Automaton dfa = timed(r, [&] { return search.dfa(); });
+    check(r, dfa.size() == expected.size() && equivalent(dfa, expected),
+          "IncrementalDeterminizer, recherche de mots");
+}
+
+void expressions(Result& r, mt19937& rng) {
+    int positions = 0;
+    string expression = randomRegex(rng, 4, positions);
+    Automaton aut = timed(r, [&] { return glushkov(expression); });
+    check(r, aut.size() == positions + 1 && aut.get_inits().size() == 1 && aut.get_inits().mem(0),
+          "glushkov /" + expression + "/ : un etat par position");
+    regex reference(expression);
+    Matcher matcher(aut);
+    bool same = true;
+    bool sameMatcher = true;
+    for (const string& w : randomWords(rng, 30, 8)) {
+        bool expected = regex_match(w, reference);
+        same = same && appartient(aut, w) == expected;
+        sameMatcher = sameMatcher && matcher.appartient(w) == expected;
+    }
+    check(r, same, "glushkov /" + expression + "/");
+    check(r, sameMatcher, "Matcher /" + expression + "/");
+
+    static const vector<string> malformed = {"(a", "a|(b", "a)", "[ab", "*a", "a\\"};
+    const string& bad = malformed[rng() % malformed.size()];
+    bool rejected = false;
+    try {
+        glushkov(bad);
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    check(r, rejected, "glushkov /" + bad + "/ rejetee");
+}
+
+void wordExtraction(Result& r, mt19937& rng) {
+    // Un langage non vide a un mot plus court que le nombre d'états : les
+    // mots de longueur au plus 6 suffisent à trouver le plus court
+    Automaton aut = randomAutomaton(rng, 6);
+    vector<string> accepted;
+    for (const string& w : allWords(6)) {
+        if (appartient(aut, w)) {
+            accepted.push_back(w);
+        }
+    }
+
+    string shortest;
+    bool found = timed(r, [&] { return shortestWord(aut, shortest); });
+    check(r, found == !accepted.empty()
+                 && (!found || (shortest.size() == accepted[0].size() && appartient(aut, shortest))),
+          "shortestWord");
+
+    vector<string> enumerated;
+    timed(r, [&] {
+        enumerateWords(aut, 6, [&](const string& w) {
+            enumerated.push_back(w);
+            return true;
+        });
+        return 0;
+    });
+    check(r, enumerated == accepted, "enumerateWords");
+
+    // Arrêt demandé par f après trois mots
+    vector<string> first;
+    timed(r, [&] {
+        enumerateWords(aut, 6, [&](const string& w) {
+            first.push_back(w);
+            return first.size() < 3;
+        });
+        return 0;
+    });
+    check(r, first == vector<string>(accepted.begin(), accepted.begin() + min<size_t>(3, accepted.size())),
+          "enumerateWords interrompu");
+}
+
+// Distances de center aux autres états, les transitions étant suivies
+// dans les deux sens (-1 : non relié)
+vector<int> undirectedDistances(const Automaton& aut, int center) {
+    vector<int> dist(aut.size(), -1);
+    vector<int> order = {center};
+    dist[center] = 0;
+    for (size_t head = 0; head < order.size(); ++head) {
+        int q = order[head];
+        for (const auto& t : aut.get_trans()) {
+            int other = get<0>(t) == q ? get<2>(t) : get<2>(t) == q ? get<0>(t) : -1;
+            if (other >= 0 && dist[other] < 0) {
+                dist[other] = dist[q] + 1;
+                order.push_back(other);
+            }
+        }
+    }
+    return dist;
+}
+
+void display(Result& r, mt19937& rng) {
+    Automaton aut = randomAutomaton(rng, 12);
+    int n = aut.size();
+    GraphModel model = timed(r, [&] { return GraphModel(aut); });
+
+    // Composantes : comme pour parallelScc, et tailles cohérentes
+    vector<IdxSet<int>> reachable;
+    for (int q = 0; q < n; ++q) {
+        IdxSet<int> src;
+        src.add(q);
+        reachable.push_back(succesorsStar(aut, src));
+    }
+    bool same = model.size() == n;
+    vector<int> sizes(model.nb_components(), 0);
+    for (int p = 0; same && p < n; ++p) {
+        ++sizes[model.component(p)];
+        same = same && model.is_init(p) == aut.get_inits().mem(p)
+               && model.is_final(p) == aut.get_finals().mem(p);
+        for (int q = 0; q < n; ++q) {
+            bool together = reachable[p].mem(q) && reachable[q].mem(p);
+            same = same && together == (model.component(p) == model.component(q));
+        }
+    }
+    for (int c = 0; same && c < model.nb_components(); ++c) {
+        same = sizes[c] == model.component_size(c);
+    }
+    check(r, same && aut.get_inits().mem(model.first_init()), "GraphModel");
+
+    // Voisinage : distances exactes, croissantes, complet sous maxStates
+    int center = rng() % n;
+    int radius = rng() % 4;
+    size_t maxStates = 1 + rng() % n;
+    vector<int> distances;
+    vector<int> states = timed(r, [&] { return model.neighbourhood(center, radius, maxStates, &distances); });
+    vector<int> expected = undirectedDistances(aut, center);
+    bool ok = !states.empty() && states[0] == center && states.size() <= maxStates
+              && distances.size() == states.size();
+    set<int> shown;
+    for (size_t i = 0; ok && i < states.size(); ++i) {
+        ok = shown.insert(states[i]).second && distances[i] == expected[states[i]]
+             && distances[i] <= radius && (i == 0 || distances[i - 1] <= distances[i]);
+    }
+    if (ok && states.size() < maxStates) {
+        for (int q = 0; q < n; ++q) {
+            ok = ok && (shown.count(q) == 1) == (expected[q] >= 0 && expected[q] <= radius);
+        }
+    }
+    check(r, ok, "GraphModel::neighbourhood");
+
+    // Placement : chaque état du voisinage dans un seul noeud, replié
+    // selon la taille de sa composante, arcs couvrant les transitions
+    size_t threshold = rng() % 4;
+    vector<int> expanded;
+    for (int c = 0; c < model.nb_components(); ++c) {
+        if (rng() % 3 == 0) {
+            expanded.push_back(c);
+        }
+    }
+    GraphLayout layout = timed(r, [&] {
+        return layoutNeighbourhood(model, center, radius, maxStates, threshold, expanded);
+    });
+    map<int, int> nodeOf;
+    ok = layout.center == center;
+    for (size_t v = 0; ok && v < layout.nodes.size(); ++v) {
+        const GraphNode& node = layout.nodes[v];
+        int c = node.component;
+        bool collapse = static_cast<size_t>(model.component_size(c)) > threshold
+                        && find(expanded.begin(), expanded.end(), c) == expanded.end();
+        ok = collapse == (node.state < 0)
+             && node.size == (collapse ? model.component_size(c) : 1);
+        for (size_t w = 0; w < v; ++w) {
+            ok = ok && (layout.nodes[w].x != node.x || layout.nodes[w].y != node.y);
+        }
+    }
+    for (int q : states) {
+        int c = model.component(q);
+        for (size_t v = 0; v < layout.nodes.size(); ++v) {
+            const GraphNode& node = layout.nodes[v];
+            if (node.state == q || (node.state < 0 && node.component == c)) {
+                ok = ok && nodeOf.emplace(q, static_cast<int>(v)).second;
+            }
+        }
+    }
+    ok = ok && nodeOf.size() == states.size();
+    map<pair<int, int>, vector<char>> arcs;
+    for (const auto& t : aut.get_trans()) {
+        auto from = nodeOf.find(get<0>(t));
+        auto to = nodeOf.find(get<2>(t));
+        if (from != nodeOf.end() && to != nodeOf.end()
+            && (from->second != to->second || layout.nodes[from->second].state >= 0)) {
+            arcs[make_pair(from->second, to->second)].push_back(get<1>(t));
+        }
+    }
+    ok = ok && layout.edges.size() == arcs.size();
+    for (const GraphEdge& e : layout.edges) {
+        auto it = arcs.find(make_pair(e.from, e.to));
+        ok = ok && it != arcs.end() && e.label == letterLabel(it->second);
+    }
+    check(r, ok, "layoutNeighbourhood");
+
+    // Étiquettes : intervalles d'au moins trois lettres, caractères
+    // spéciaux échappés
+    check(r, letterLabel({'e', 'b', 'a', 'c', 'a'}) == "a-c,e" && letterLabel({'x', 'y'}) == "x,y"
+                 && letterLabel({}) == "" && letterLabel({',', '-', '\\'}) == "\\x2C,\\x2D,\\x5C"
+                 && letterLabel({' ', '\n'}) == "\\x0A,\\x20",
+          "letterLabel");
+
+    // DOT : finals, flèches initiales et un arc étiqueté par couple d'états
+    ostringstream dot;
+    timed(r, [&] {
+        writeDot(aut, dot);
+        return 0;
+    });
+    map<pair<int, int>, vector<char>> byPair;
+    for (const auto& t : aut.get_trans()) {
+        byPair[make_pair(get<0>(t), get<2>(t))].push_back(get<1>(t));
+    }
+    istringstream lines(dot.str());
+    string line;
+    getline(lines, line);
+    ok = line == "digraph automate {";
+    size_t nbFinals = 0;
+    size_t nbInits = 0;
+    size_t nbArcs = 0;
+    string last;
+    while (getline(lines, line)) {
+        last = line;
+        int p;
+        int q;
+        char label[64];
+        if (sscanf(line.c_str(), " %d -> %d [label=\"%63[^\"]\"];", &p, &q, label) == 3) {
+            auto it = byPair.find(make_pair(p, q));
+            ok = ok && it != byPair.end() && letterLabel(it->second) == label;
+            ++nbArcs;
+        } else if (sscanf(line.c_str(), " %d [shape=doublecircle];", &p) == 1) {
+            ok = ok && aut.get_finals().mem(p);
+            ++nbFinals;
+        } else if (sscanf(line.c_str(), " init%d -> %d;", &p, &q) == 2) {
+            ok = ok && p == q && aut.get_inits().mem(p);
+            ++nbInits;
+        }
+    }
+    check(r, ok && last == "}" && nbArcs == byPair.size() && nbFinals == aut.get_finals().size()
+                 && nbInits == aut.get_inits().size(),
+          "writeDot");
+}
+
+map<string, double> readBaseline(const string& path) {
+    map<string, double> baseline;
+    ifstream in(path);
+    string name;
+    double seconds;
+    while (in >> name >> seconds) {
+        baseline[name] = seconds;
+    }
+    return baseline;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned seed = 1;
+    int iterations = 200;
+    string baselinePath = "automaton_check_baseline.txt";
+    double threshold = 1.25;
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--update") {
+            update = true;
+        } else if (i + 1 < argc && arg == "--seed") {
+            seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (i + 1 < argc && arg == "--iterations") {
+            iterations = atoi(argv[++i]);
+        } else if (i + 1 < argc && arg == "--baseline") {
+            baselinePath = argv[++i];
+        } else if (i + 1 < argc && arg == "--threshold") {
+            threshold = atof(argv[++i]);
+        } else {
+            cerr << "usage : " << argv[0] << " [--seed N] [--iterations N] [--baseline fichier]"
+                 << " [--threshold R] [--update]" << endl;
+            return 2;
+        }
+    }
+
+    Harness harness(seed, iterations);
+    harness.run("appartenance", membership);
+    harness.run("determinisation", determinization);
+    harness.run("intersection", intersections);
+    harness.run("emondage", trimming);
+    harness.run("composantes", components);
+    harness.run("complementaire", complementation);
+    harness.run("cache", caching);
+    harness.run("equivalence", equivalences);
+    harness.run("debordement", spilling);
+    harness.run("mutations", mutations);
+    harness.run("expressions", expressions);
+    harness.run("mots", wordExtraction);
+    harness.run("affichage", display);
+
+    map<string, double> baseline = readBaseline(baselinePath);
+    bool ok = true;
+    for (const Result& r : harness.get_results()) {
+        cout << r.name << " : " << r.cases << " cas, " << r.failures << " echec(s), "
+             << r.seconds * 1000 << " ms";
+        auto it = baseline.find(r.name);
+        if (it != baseline.end() && it->second > 0) {
+            double ratio = r.seconds / it->second;
+            cout << " (x" << ratio << " par rapport a la reference)";
+            if (ratio > threshold && !update) {
+                cout << " RALENTISSEMENT";
+                ok = false;
+            }
+        }
+        cout << endl;
+        if (r.failures > 0) {
+            cout << "  premier echec : " << r.firstFailure << endl;
+            ok = false;
+        }
+    }
+
+    if (update) {
+        ofstream out(baselinePath);
+        for (const Result& r : harness.get_results()) {
+            out << r.name << " " << r.seconds << "\n";
+        }
+        if (!out) {
+            cerr << argv[0] << " : écriture impossible dans " << baselinePath << endl;
+            return 1;
+        }
+        cout << "Temps de reference ecrits dans " << baselinePath << endl;
+    }
+    return ok ? 0 : 1;
+}
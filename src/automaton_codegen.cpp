@@ -0,0 +1,67 @@
+// Outil de génération de matchers utilisé pendant la construction :
+//   automaton_codegen <expression> <fonction> <fichier.cpp>
+// compile l'expression régulière, la déterminise et écrit dans le fichier
+// la fonction bool <fonction>(std::string_view), ainsi que la constante
+// const char* const <fonction>_regex contenant l'expression d'origine.
+
+#include "codegen.h"
+#include "operations.h"
+#include "regex.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// Littéral C++ représentant s
+string cppLiteral(const string& s) {
+    ostringstream os;
+    os << '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (c < 32 || c > 126) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\%03o", c);
+            os << buf;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        cerr << "usage : " << argv[0] << " <expression> <fonction> <fichier.cpp>" << endl;
+        return 2;
+    }
+    string regex = argv[1];
+    string function = argv[2];
+
+    try {
+        Automaton dfa = determinize(trim(glushkov(regex)));
+        ostringstream code;
+        generateMatcher(dfa, function, code);
+        code << "\nextern const char* const " << function << "_regex;\n"
+             << "const char* const " << function << "_regex = " << cppLiteral(regex) << ";\n";
+
+        ofstream out(argv[3]);
+        out << code.str();
+        if (!out) {
+            cerr << argv[0] << " : écriture impossible dans " << argv[3] << endl;
+            return 1;
+        }
+    } catch (const invalid_argument& e) {
+        cerr << argv[0] << " : " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,345 @@
+#include "automatongraphview.h"
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QRunnable>
+#include <QStyleOptionGraphicsItem>
+#include <QWheelEvent>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// En dessous de ces niveaux de détail, on ne dessine ni les étiquettes ni
+// les flèches et les états deviennent des disques pleins
+const qreal labelDetail = 0.6;
+const qreal shapeDetail = 0.3;
+
+qreal nodeRadius(const GraphNode& node) {
+    if (node.state >= 0) {
+        return 18;
+    }
+    return min<qreal>(18 + 6 * std::log2(static_cast<qreal>(node.size)), 60);
+}
+
+// Calcul confié au pool, détruit par lui une fois exécuté.
+// QThreadPool::start(std::function) n'existe qu'à partir de Qt 5.15.
+class Task : public QRunnable {
+public:
+    explicit Task(function<void()> work) : work(std::move(work)) {}
+
+    void run() override {
+        work();
+    }
+
+private:
+    function<void()> work;
+};
+
+class StateItem : public QGraphicsItem {
+public:
+    enum { Type = UserType + 1 };
+
+    explicit StateItem(const GraphNode& node, bool isCenter)
+        : node(node), isCenter(isCenter), r(nodeRadius(node)) {
+        setPos(node.x, node.y);
+        setZValue(1);
+        setToolTip(node.state >= 0
+                       ? QString("Etat %1").arg(node.state)
+                       : QString("Composante %1 : %2 etats (double clic pour deplier)")
+                             .arg(node.component).arg(node.size));
+    }
+
+    int type() const override {
+        return Type;
+    }
+
+    QRectF boundingRect() const override {
+        // Place de la flèche d'entrée des états initiaux
+        return QRectF(-r - 16, -r - 2, 2 * r + 18, 2 * r + 4);
+    }
+
+    qreal radius() const {
+        return r;
+    }
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) override {
+        qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+        QColor fill = node.state < 0 ? QColor(255, 224, 160)
+                      : isCenter   ? QColor(170, 210, 255)
+                                   : QColor(235, 235, 235);
+        if (lod < shapeDetail) {
+            painter->fillRect(QRectF(-r, -r, 2 * r, 2 * r), fill);
+            return;
+        }
+        QPen pen(Qt::black, isCenter ? 2.5 : 1.2);
+        if (node.frontier) {
+            pen.setStyle(Qt::DashLine);
+        }
+        painter->setPen(pen);
+        painter->setBrush(fill);
+        painter->drawEllipse(QPointF(0, 0), r, r);
+        if (node.final) {
+            painter->setBrush(Qt::NoBrush);
+            painter->drawEllipse(QPointF(0, 0), r - 4, r - 4);
+        }
+        if (node.init) {
+            painter->setPen(QPen(Qt::black, 1.2));
+            painter->drawLine(QPointF(-r - 14, 0), QPointF(-r, 0));
+            painter->drawLine(QPointF(-r - 5, -4), QPointF(-r, 0));
+            painter->drawLine(QPointF(-r - 5, 4), QPointF(-r, 0));
+        }
+        if (lod >= labelDetail) {
+            QString text = node.state >= 0 ? QString::number(node.state)
+                                           : QString("[%1]").arg(node.size);
+            painter->drawText(QRectF(-r, -r, 2 * r, 2 * r), Qt::AlignCenter, text);
+        }
+    }
+
+    const GraphNode node;
+
+private:
+    bool isCenter;
+    qreal r;
+};
+
+class EdgeItem : public QGraphicsItem {
+public:
+    EdgeItem(const StateItem *from, const StateItem *to, const QString& label)
+        : label(label) {
+        QPointF a = from->pos();
+        QPointF b = to->pos();
+        if (from == to) {
+            // Boucle au-dessus de l'état
+            qreal r = from->radius();
+            path.moveTo(a + QPointF(-r / 2, -r + 2));
+            path.cubicTo(a + QPointF(-r, -2.5 * r), a + QPointF(r, -2.5 * r),
+                         a + QPointF(r / 2, -r + 2));
+            tip = a + QPointF(r / 2, -r + 2);
+            tipDir = QPointF(-0.3, 1);
+            labelPos = a + QPointF(0, -2 * r - 4);
+        } else {
+            // Légère courbe : les arcs p -> q et q -> p ne se recouvrent pas
+            QPointF d = b - a;
+            qreal len = std::hypot(d.x(), d.y());
+            QPointF u = d / len;
+            QPointF normal(u.y(), -u.x());
+            QPointF start = a + u * from->radius();
+            QPointF end = b - u * to->radius();
+            QPointF control = (start + end) / 2 + normal * min<qreal>(25, len / 6);
+            path.moveTo(start);
+            path.quadTo(control, end);
+            tip = end;
+            tipDir = end - control;
+            labelPos = (start + end) / 2 + normal * min<qreal>(25, len / 6) / 2;
+        }
+        qreal norm = std::hypot(tipDir.x(), tipDir.y());
+        tipDir = norm > 0 ? tipDir / norm : QPointF(1, 0);
+        bounds = path.boundingRect()
+                     .united(QRectF(labelPos - QPointF(60, 14), QSizeF(120, 16)))
+                     .adjusted(-8, -8, 8, 8);
+    }
+
+    QRectF boundingRect() const override {
+        return bounds;
+    }
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) override {
+        qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+        painter->setPen(QPen(Qt::darkGray, 1));
+        painter->setBrush(Qt::NoBrush);
+        if (lod < shapeDetail) {
+            painter->drawLine(path.pointAtPercent(0), tip);
+            return;
+        }
+        painter->drawPath(path);
+        QPointF normal(tipDir.y(), -tipDir.x());
+        QPolygonF head;
+        head << tip << tip - tipDir * 9 + normal * 4 << tip - tipDir * 9 - normal * 4;
+        painter->setBrush(Qt::darkGray);
+        painter->drawPolygon(head);
+        if (lod >= labelDetail) {
+            painter->setPen(Qt::black);
+            painter->drawText(QRectF(labelPos - QPointF(60, 14), QSizeF(120, 16)),
+                              Qt::AlignCenter, label);
+        }
+    }
+
+private:
+    QString label;
+    QPainterPath path;
+    QPointF tip;
+    QPointF tipDir;
+    QPointF labelPos;
+    QRectF bounds;
+};
+
+} // namespace
+
+AutomatonGraphView::AutomatonGraphView(QWidget *parent)
+    : QGraphicsView(parent)
+    , scene(new QGraphicsScene(this))
+    , center(-1)
+    , generation(0)
+    , nextNode(0)
+    , nextEdge(0)
+{
+    setScene(scene);
+    setRenderHint(QPainter::Antialiasing);
+    setDragMode(QGraphicsView::ScrollHandDrag);
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing);
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+
+    batchTimer.setInterval(0);
+    connect(&batchTimer, &QTimer::timeout, this, &AutomatonGraphView::insertBatch);
+    pool.setMaxThreadCount(1);
+}
+
+AutomatonGraphView::~AutomatonGraphView()
+{
+    // Le calcul en cours adresse encore ses résultats à this
+    pool.clear();
+    pool.waitForDone();
+}
+
+void AutomatonGraphView::runInBackground(function<void()> work)
+{
+    pool.clear();
+    pool.start(new Task(std::move(work)));
+}
+
+void AutomatonGraphView::setAutomaton(const Automaton& aut)
+{
+    unsigned gen = ++generation;
+    batchTimer.stop();
+    scene->clear();
+    nodeItems.clear();
+    model.reset();
+    expanded.clear();
+    emit statusMessage(QString("Analyse de l'automate (%1 etats)...").arg(aut.size()));
+
+    runInBackground([this, gen, aut]() {
+        shared_ptr<const GraphModel> built = make_shared<GraphModel>(aut);
+        QMetaObject::invokeMethod(this, [this, gen, built]() {
+            if (gen != generation) {
+                return;
+            }
+            model = built;
+            showNeighbourhood(model->first_init());
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AutomatonGraphView::showNeighbourhood(int c)
+{
+    if (!model || c < 0 || c >= model->size()) {
+        return;
+    }
+    center = c;
+    relayout();
+}
+
+void AutomatonGraphView::expandComponent(int c)
+{
+    if (find(expanded.begin(), expanded.end(), c) == expanded.end()) {
+        expanded.push_back(c);
+    }
+    relayout();
+}
+
+void AutomatonGraphView::relayout()
+{
+    if (!model) {
+        return;
+    }
+    unsigned gen = ++generation;
+    emit statusMessage(QString("Placement du voisinage de l'etat %1...").arg(center));
+
+    shared_ptr<const GraphModel> m = model;
+    int c = center;
+    vector<int> exp = expanded;
+    runInBackground([this, gen, m, c, exp]() {
+        GraphLayout layout = layoutNeighbourhood(*m, c, radius, maxStates,
+                                                 collapseThreshold, exp);
+        QMetaObject::invokeMethod(this, [this, gen, layout]() {
+            if (gen != generation) {
+                return;
+            }
+            batchTimer.stop();
+            scene->clear();
+            nodeItems.clear();
+            pending = layout;
+            nextNode = 0;
+            nextEdge = 0;
+            batchTimer.start();
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AutomatonGraphView::insertBatch()
+{
+    // Les états d'abord : les arcs ont besoin de leurs positions
+    int budget = batchSize;
+    for (; budget > 0 && nextNode < pending.nodes.size(); --budget, ++nextNode) {
+        const GraphNode& node = pending.nodes[nextNode];
+        StateItem *item = new StateItem(node, node.state == pending.center);
+        scene->addItem(item);
+        nodeItems.push_back(item);
+    }
+    for (; budget > 0 && nextEdge < pending.edges.size(); --budget, ++nextEdge) {
+        const GraphEdge& edge = pending.edges[nextEdge];
+        scene->addItem(new EdgeItem(static_cast<StateItem*>(nodeItems[edge.from]),
+                                    static_cast<StateItem*>(nodeItems[edge.to]),
+                                    QString::fromStdString(edge.label)));
+    }
+    if (nextNode < pending.nodes.size() || nextEdge < pending.edges.size()) {
+        return;
+    }
+
+    batchTimer.stop();
+    scene->setSceneRect(scene->itemsBoundingRect().adjusted(-50, -50, 50, 50));
+    if (!nodeItems.empty()) {
+        centerOn(nodeItems.front());
+    }
+    emit statusMessage(QString("%1 etats, %2 composantes ; voisinage de l'etat %3 : "
+                               "%4 noeuds, %5 arcs")
+                           .arg(model->size()).arg(model->nb_components()).arg(pending.center)
+                           .arg(pending.nodes.size()).arg(pending.edges.size()));
+}
+
+void AutomatonGraphView::wheelEvent(QWheelEvent *event)
+{
+    qreal factor = qPow(1.0015, event->angleDelta().y());
+    scale(factor, factor);
+    event->accept();
+}
+
+void AutomatonGraphView::mouseDoubleClickEvent(QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPoint at = event->position().toPoint();
+#else
+    QPoint at = event->pos();
+#endif
+    for (QGraphicsItem *item : items(at)) {
+        if (item->type() != StateItem::Type) {
+            continue;
+        }
+        const GraphNode& node = static_cast<StateItem*>(item)->node;
+        if (node.state >= 0) {
+            showNeighbourhood(node.state);
+        } else {
+            expandComponent(node.component);
+        }
+        event->accept();
+        return;
+    }
+    QGraphicsView::mouseDoubleClickEvent(event);
+}
@@ -0,0 +1,95 @@
+// Compare, sur les mêmes entrées, le matcher généré à la construction par
+// automaton_codegen (fonction bench_matcher) et le moteur à table DfaTable
+// construit à l'exécution à partir de la même expression.
+
+#include "dfatable.h"
+#include "operations.h"
+#include "regex.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+bool bench_matcher(std::string_view word);
+extern const char* const bench_matcher_regex;
+
+namespace {
+
+// Mots de test : un quart reconnus par construction, le reste aléatoire
+vector<string> makeInputs(size_t count) {
+    mt19937 rng(42);
+    const string lower = "abcdefghijklmnopqrstuvwxyz";
+    const string noise = lower + "@.-_0123456789";
+    const char* tlds[] = {"com", "org", "net"};
+    vector<string> inputs;
+    for (size_t i = 0; i < count; ++i) {
+        string w;
+        if (i % 4 == 0) {
+            for (int k = 0, n = 3 + rng() % 12; k < n; ++k) {
+                w += lower[rng() % lower.size()];
+            }
+            w += '@';
+            for (int k = 0, n = 3 + rng() % 8; k < n; ++k) {
+                w += lower[rng() % lower.size()];
+            }
+            w += '.';
+            w += tlds[rng() % 3];
+        } else {
+            for (int k = 0, n = 5 + rng() % 30; k < n; ++k) {
+                w += noise[rng() % noise.size()];
+            }
+        }
+        inputs.push_back(w);
+    }
+    return inputs;
+}
+
+template <typename Matcher>
+double nsPerByte(const vector<string>& inputs, size_t bytes, int rounds, Matcher match, size_t& accepted) {
+    accepted = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const string& w : inputs) {
+            accepted += match(w) ? 1 : 0;
+        }
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return ns / (static_cast<double>(bytes) * rounds);
+}
+
+} // namespace
+
+int main() {
+    DfaTable table(determinize(trim(glushkov(bench_matcher_regex))));
+    vector<string> inputs = makeInputs(200000);
+    size_t bytes = 0;
+    for (const string& w : inputs) {
+        bytes += w.size();
+    }
+
+    for (const string& w : inputs) {
+        if (bench_matcher(w) != table.appartient(w)) {
+            cerr << "Résultats différents pour \"" << w << "\"" << endl;
+            return 1;
+        }
+    }
+
+    const int rounds = 20;
+    size_t acceptedGen, acceptedTable;
+    double gen = nsPerByte(inputs, bytes, rounds,
+                           [](const string& w) { return bench_matcher(w); }, acceptedGen);
+    double tab = nsPerByte(inputs, bytes, rounds,
+                           [&table](const string& w) { return table.appartient(w); }, acceptedTable);
+
+    cout << "Expression : " << bench_matcher_regex << endl
+         << "Entrees : " << inputs.size() << " mots, " << bytes << " octets, "
+         << acceptedGen / rounds << " reconnus" << endl
+         << "Matcher genere : " << gen << " ns/octet" << endl
+         << "Table DfaTable : " << tab << " ns/octet" << endl
+         << "Rapport : " << tab / gen << endl;
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Compare DfaTable et HybridDfa sur deux automates déterministes :
+//  - un arbre préfixe de mots de dictionnaire, où presque tous les états
+//    n'ont qu'une ou deux transitions ;
+//  - le déterminisé d'une recherche de mots-clés (.*(mot1|mot2|...)), où
+//    beaucoup d'états ont des transitions sur tout l'alphabet.
+// Pour chacun : mémoire occupée et temps par octet lu, avec le budget de
+// lignes denses par défaut et sans budget.
+
+#include "dfatable.h"
+#include "hybriddfa.h"
+#include "operations.h"
+#include "regex.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+vector<string> makeWords(size_t count, int alphabet, mt19937& rng) {
+    vector<string> words;
+    for (size_t i = 0; i < count; ++i) {
+        string w;
+        for (int k = 0, n = 4 + rng() % 9; k < n; ++k) {
+            w += static_cast<char>('a' + rng() % alphabet);
+        }
+        words.push_back(w);
+    }
+    return words;
+}
+
+// Arbre préfixe reconnaissant exactement les mots de words
+Automaton makeTrie(const vector<string>& words) {
+    Automaton trie;
+    map<pair<int, char>, int> children;
+    trie.add_init(trie.newstate());
+    for (const string& w : words) {
+        int q = 0;
+        for (char c : w) {
+            auto it = children.find(make_pair(q, c));
+            if (it == children.end()) {
+                int next = trie.newstate();
+                trie.add_trans_unchecked(q, c, next);
+                it = children.emplace(make_pair(q, c), next).first;
+            }
+            q = it->second;
+        }
+        trie.add_final(q);
+    }
+    return trie;
+}
+
+// Meilleur temps sur rounds passes, pour écarter les perturbations
+template <typename Dfa>
+double nsPerByte(const Dfa& dfa, const vector<string>& inputs, size_t bytes,
+                 int rounds, size_t& accepted) {
+    double best = 0;
+    for (int r = 0; r < rounds; ++r) {
+        accepted = 0;
+        auto start = chrono::steady_clock::now();
+        for (const string& w : inputs) {
+            accepted += dfa.appartient(w) ? 1 : 0;
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best / static_cast<double>(bytes);
+}
+
+bool compare(const string& name, const Automaton& dfa, const vector<string>& inputs) {
+    size_t bytes = 0;
+    for (const string& w : inputs) {
+        bytes += w.size();
+    }
+    DfaTable table(dfa);
+    HybridDfa hybrid(dfa);
+    HybridDfa compact(dfa, 0);
+    cout << name << endl << hybrid.report()
+         << "Sans budget dense : " << compact.report();
+
+    const int rounds = 10;
+    size_t expected;
+    size_t accepted;
+    size_t acceptedCompact;
+    double dense = nsPerByte(table, inputs, bytes, rounds, expected);
+    double mixed = nsPerByte(hybrid, inputs, bytes, rounds, accepted);
+    double sparse = nsPerByte(compact, inputs, bytes, rounds, acceptedCompact);
+    if (accepted != expected || acceptedCompact != expected) {
+        cerr << name << " : resultats differents de DfaTable" << endl;
+        return false;
+    }
+    cout << "DfaTable : " << dense << " ns/octet, HybridDfa : " << mixed
+         << " ns/octet (rapport " << mixed / dense << "), sans budget dense : " << sparse
+         << " ns/octet (rapport " << sparse / dense << ")" << endl << endl;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    mt19937 rng(42);
+
+    vector<string> dictionary = makeWords(20000, 26, rng);
+    vector<string> inputs;
+    for (size_t i = 0; i < 200000; ++i) {
+        inputs.push_back(i % 4 == 0 ? makeWords(1, 26, rng)[0]
+                                    : dictionary[rng() % dictionary.size()]);
+    }
+    if (!compare("Arbre prefixe", makeTrie(dictionary), inputs)) {
+        return 1;
+    }
+
+    vector<string> keywords = makeWords(40, 8, rng);
+    string regex = "(a|b|c|d|e|f|g|h)*(" + keywords[0];
+    for (size_t i = 1; i < keywords.size(); ++i) {
+        regex += "|" + keywords[i];
+    }
+    regex += ")";
+    Automaton search = determinize(glushkov(regex));
+    vector<string> texts = makeWords(50000, 8, rng);
+    if (!compare("Recherche de mots-cles", search, texts)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Compare les parcours séquentiels et parallèles sur deux grands automates :
+//  - un automate aléatoire, où presque tous les états sont dans une
+//    composante géante et où le parcours atteint la moitié des états en
+//    quelques niveaux ;
+//  - une longue chaîne avec des raccourcis et des retours, où le parcours
+//    compte des milliers de niveaux de petite frontière.
+// Pour chacun : temps de forwardReach contre parallelForwardReach, et de
+// Tarjan contre parallelScc, pour 1, 2, 4 threads et le nombre de coeurs.
+// Tous les temps sont pris sur le même index d'adjacence, construit avant
+// les mesures ; GraphModel ne sert qu'à vérifier les composantes.
+
+#include "adjacency.h"
+#include "graphmodel.h"
+#include "parallelgraph.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+Automaton makeRandom(int n, int degree, mt19937& rng) {
+    Automaton aut;
+    for (int i = 0; i < n; ++i) {
+        aut.newstate();
+    }
+    for (int q = 0; q < n; ++q) {
+        for (int k = 0; k < degree; ++k) {
+            aut.add_trans_unchecked(q, static_cast<char>('a' + k), rng() % n);
+        }
+    }
+    aut.add_init(0);
+    aut.add_final(n - 1);
+    return aut;
+}
+
+Automaton makeChain(int n, mt19937& rng) {
+    Automaton aut;
+    for (int i = 0; i < n; ++i) {
+        aut.newstate();
+    }
+    for (int q = 0; q + 1 < n; ++q) {
+        aut.add_trans_unchecked(q, 'a', q + 1);
+        if (q % 7 == 0 && q + 10 < n) {
+            aut.add_trans_unchecked(q, 'b', q + 10);
+        }
+        if (q % 1000 == 999) {
+            aut.add_trans_unchecked(q, 'c', q - static_cast<int>(rng() % 500));
+        }
+    }
+    aut.add_init(0);
+    aut.add_final(n - 1);
+    return aut;
+}
+
+// Meilleur temps en millisecondes sur rounds passes
+template <typename F>
+double bestMs(int rounds, F f) {
+    double best = 0;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = chrono::steady_clock::now();
+        f();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (r == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+// Même partition des états, à la numérotation des composantes près
+bool samePartition(const GraphModel& model, const SccDecomposition& scc) {
+    vector<int> mapping(model.nb_components(), -1);
+    for (int q = 0; q < model.size(); ++q) {
+        int& c = mapping[model.component(q)];
+        if (c < 0) {
+            c = scc.component[q];
+        } else if (c != scc.component[q]) {
+            return false;
+        }
+    }
+    return scc.count() == model.nb_components();
+}
+
+bool compare(const string& name, const Automaton& aut, const vector<unsigned>& threads) {
+    const int rounds = 3;
+    Adjacency adj(aut);
+    cout << name << " : " << aut.size() << " états, " << aut.get_trans().size() << " transitions"
+         << endl;
+
+    vector<bool> expected;
+    double serialReach = bestMs(rounds, [&] { expected = forwardReach(adj, aut.get_inits()); });
+    cout << "forwardReach : " << serialReach << " ms" << endl;
+    for (unsigned t : threads) {
+        vector<bool> reached;
+        double ms = bestMs(rounds, [&] { reached = parallelForwardReach(adj, aut.get_inits(), t); });
+        if (reached != expected) {
+            cerr << name << " : accessibilité différente avec " << t << " threads" << endl;
+            return false;
+        }
+        cout << "parallelForwardReach, " << t << " threads : " << ms << " ms (rapport "
+             << ms / serialReach << ")" << endl;
+    }
+
+    GraphModel model(aut);
+    SccDecomposition tarjan;
+    double serialScc = bestMs(rounds, [&] { tarjan = tarjanScc(adj); });
+    if (!samePartition(model, tarjan)) {
+        cerr << name << " : composantes de Tarjan différentes de GraphModel" << endl;
+        return false;
+    }
+    cout << "Tarjan : " << serialScc << " ms, " << tarjan.count() << " composantes" << endl;
+    for (unsigned t : threads) {
+        SccDecomposition scc;
+        double ms = bestMs(rounds, [&] { scc = parallelScc(adj, t); });
+        if (!samePartition(model, scc)) {
+            cerr << name << " : composantes différentes avec " << t << " threads" << endl;
+            return false;
+        }
+        cout << "parallelScc, " << t << " threads : " << ms << " ms (rapport "
+             << ms / serialScc << ")" << endl;
+    }
+    cout << endl;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    mt19937 rng(42);
+    vector<unsigned> threads = {1, 2, 4};
+    unsigned cores = thread::hardware_concurrency();
+    if (cores > 4) {
+        threads.push_back(cores);
+    }
+    cout << cores << " coeurs" << endl << endl;
+
+    if (!compare("Automate aléatoire", makeRandom(1000000, 3, rng), threads)) {
+        return 1;
+    }
+    if (!compare("Chaîne avec raccourcis", makeChain(2000000, rng), threads)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+// Mesure l'effet de la numérotation des états sur la lecture d'un grand
+// automate déterministe : un arbre préfixe de mots de dictionnaire, dont
+// la table DfaTable dépasse largement le cache L2. La référence est la
+// numérotation que donnerait determinize : ordre de découverte, les fils
+// d'un état recevant des numéros consécutifs au moment où il est traité,
+// le dernier découvert étant traité en premier. determinize, quadratique
+// en le nombre d'états, est trop lent sur cet arbre : son ordre est
+// reproduit, et vérifié sur un petit dictionnaire. Viennent ensuite
+// l'ordre de création (newstate, mot après mot), puis les réordonnancements
+// en largeur d'abord, en profondeur d'abord et selon les fréquences de
+// visite mesurées sur un échantillon d'apprentissage distinct des entrées
+// mesurées.
+//
+// Le temps par octet sert d'indicateur ; pour compter les défauts de cache
+// eux-mêmes : perf stat -e cache-misses ./bench_renumber
+
+#include "dfatable.h"
+#include "operations.h"
+#include "renumber.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+vector<string> makeDictionary(size_t count, mt19937& rng) {
+    vector<string> words;
+    for (size_t i = 0; i < count; ++i) {
+        string w;
+        for (int k = 0, n = 4 + rng() % 9; k < n; ++k) {
+            w += static_cast<char>('a' + rng() % 26);
+        }
+        words.push_back(w);
+    }
+    return words;
+}
+
+// Arbre préfixe reconnaissant exactement les mots de words
+Automaton makeTrie(const vector<string>& words) {
+    Automaton trie;
+    map<pair<int, char>, int> children;
+    trie.add_init(trie.newstate());
+    vector<bool> final(1, false);
+    for (const string& w : words) {
+        int q = 0;
+        for (char c : w) {
+            auto it = children.find(make_pair(q, c));
+            if (it == children.end()) {
+                int next = trie.newstate();
+                final.push_back(false);
+                trie.add_trans_unchecked(q, c, next);
+                it = children.emplace(make_pair(q, c), next).first;
+            }
+            q = it->second;
+        }
+        if (!final[q]) {
+            final[q] = true;
+            trie.add_final_unchecked(q);
+        }
+    }
+    return trie;
+}
+
+// Ordre dans lequel determinize numéroterait les états de l'automate
+// déterministe accessible aut : les successeurs d'un état, lettres dans
+// l'ordre de get_alphabet(), sont numérotés quand il est traité, et le
+// dernier numéroté est traité le premier (IdxSet::choose)
+vector<int> determinizeOrder(const Automaton& aut) {
+    map<pair<int, char>, int> successor;
+    for (const auto& t : aut.get_trans()) {
+        successor[make_pair(get<0>(t), get<1>(t))] = get<2>(t);
+    }
+    vector<int> number(aut.size(), -1);
+    vector<int> order;
+    vector<int> pending;
+    for (int q : aut.get_inits()) {
+        number[q] = static_cast<int>(order.size());
+        order.push_back(q);
+        pending.push_back(q);
+    }
+    while (!pending.empty()) {
+        int q = pending.back();
+        pending.pop_back();
+        for (char c : aut.get_alphabet()) {
+            auto it = successor.find(make_pair(q, c));
+            if (it != successor.end() && number[it->second] < 0) {
+                number[it->second] = static_cast<int>(order.size());
+                order.push_back(it->second);
+                pending.push_back(it->second);
+            }
+        }
+    }
+    return order;
+}
+
+// determinizeOrder donne bien l'automate que construit determinize
+bool sameAsDeterminize(const Automaton& trie) {
+    Automaton expected = determinize(trie);
+    Automaton renumbered = renumber(trie, determinizeOrder(trie));
+    vector<tuple<int, char, int>> a(expected.get_trans().begin(), expected.get_trans().end());
+    vector<tuple<int, char, int>> b(renumbered.get_trans().begin(), renumbered.get_trans().end());
+    vector<int> fa(expected.get_finals().begin(), expected.get_finals().end());
+    vector<int> fb(renumbered.get_finals().begin(), renumbered.get_finals().end());
+    sort(a.begin(), a.end());
+    sort(b.begin(), b.end());
+    sort(fa.begin(), fa.end());
+    sort(fb.begin(), fb.end());
+    return a == b && fa == fb;
+}
+
+// Entrées : mots du dictionnaire tirés selon une loi très inégale (les
+// premiers mots sont les plus fréquents), et un quart de mots aléatoires
+vector<string> makeInputs(const vector<string>& dictionary, size_t count, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> u(0.0, 1.0);
+    vector<string> inputs;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 4 == 0) {
+            inputs.push_back(makeDictionary(1, rng)[0]);
+        } else {
+            double x = u(rng);
+            inputs.push_back(dictionary[static_cast<size_t>(x * x * x * dictionary.size())]);
+        }
+    }
+    return inputs;
+}
+
+// Temps d'une lecture de toutes les entrées, en nanosecondes par octet
+double nsPerByte(const DfaTable& table, const vector<string>& inputs, size_t bytes,
+                 size_t& accepted) {
+    accepted = 0;
+    auto start = chrono::steady_clock::now();
+    for (const string& w : inputs) {
+        accepted += table.appartient(w) ? 1 : 0;
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return ns / static_cast<double>(bytes);
+}
+
+} // namespace
+
+int main() {
+    mt19937 rng(42);
+    if (!sameAsDeterminize(makeTrie(makeDictionary(300, rng)))) {
+        cerr << "determinizeOrder ne reproduit pas determinize" << endl;
+        return 1;
+    }
+    vector<string> dictionary = makeDictionary(20000, rng);
+    Automaton trie = makeTrie(dictionary);
+
+    // Numérotation de référence, celle de determinize
+    Automaton discovered = renumber(trie, determinizeOrder(trie));
+
+    vector<string> training = makeInputs(dictionary, 50000, 1);
+    vector<string> inputs = makeInputs(dictionary, 200000, 2);
+    size_t bytes = 0;
+    for (const string& w : inputs) {
+        bytes += w.size();
+    }
+
+    DfaTable reference(discovered);
+    cout << "Automate : " << reference.size() << " etats, table de "
+         << reference.size() * 256 * sizeof(int32_t) / (1024 * 1024) << " Mo" << endl
+         << "Entrees : " << inputs.size() << " mots, " << bytes << " octets" << endl;
+
+    DfaTable created(trie);
+    DfaTable bfs(discovered);
+    bfs.renumber(bfsOrder(discovered));
+    DfaTable dfs(discovered);
+    dfs.renumber(dfsOrder(discovered));
+    DfaTable profile(discovered);
+    profile.renumber(profileOrder(visitCounts(profile, training), dfsOrder(discovered)));
+
+    // Les passes des cinq numérotations sont alternées : une dérive de la
+    // machine pendant la mesure les touche toutes de la même façon. Le
+    // meilleur temps et le temps médian de chacune sont affichés, l'écart
+    // entre les deux donnant une idée du bruit.
+    const int rounds = 15;
+    struct Variant {
+        const char* name;
+        const DfaTable* table;
+        vector<double> times;
+    };
+    vector<Variant> variants = {{"Determinize", &reference, {}}, {"Creation", &created, {}},
+                                {"Largeur", &bfs, {}}, {"Profondeur", &dfs, {}},
+                                {"Profil", &profile, {}}};
+    size_t expected = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (Variant& v : variants) {
+            size_t accepted;
+            v.times.push_back(nsPerByte(*v.table, inputs, bytes, accepted));
+            if (v.table == &reference) {
+                expected = accepted;
+            } else if (accepted != expected) {
+                cerr << v.name << " : resultats differents de la numerotation d'origine" << endl;
+                return 1;
+            }
+        }
+    }
+    double base = 0;
+    double baseMedian = 0;
+    for (Variant& v : variants) {
+        sort(v.times.begin(), v.times.end());
+        double best = v.times.front();
+        double median = v.times[v.times.size() / 2];
+        if (v.table == &reference) {
+            base = best;
+            baseMedian = median;
+        }
+        cout << v.name << " : " << best << " ns/octet, mediane " << median << " (gain "
+             << base / best << ", sur les medianes " << baseMedian / median << ")" << endl;
+    }
+    return 0;
+}
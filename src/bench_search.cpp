@@ -0,0 +1,65 @@
+// Débit de la recherche non ancrée (Searcher) sur un journal synthétique
+// où les occurrences sont rares, comparé à memchr d'un octet absent, qui
+// borne ce qu'un préfiltre peut espérer atteindre.
+
+#include "regex.h"
+#include "search.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+// Lignes de journal en minuscules ; une ligne sur 10000 contient ERROR
+string makeLog(size_t bytes) {
+    mt19937 rng(42);
+    const string words[] = {"info", "debug", "request", "served", "user", "session",
+                            "cache", "hit", "miss", "latency", "ms", "ok"};
+    string log;
+    log.reserve(bytes + 128);
+    for (size_t line = 0; log.size() < bytes; ++line) {
+        log += "2024-09-27 12:00:00 ";
+        for (int k = 0, n = 5 + rng() % 10; k < n; ++k) {
+            log += words[rng() % 12];
+            log += ' ';
+        }
+        if (line % 10000 == 0) {
+            log += "ERROR " + to_string(rng() % 1000);
+        }
+        log += '\n';
+    }
+    return log;
+}
+
+template <typename Scan>
+double gbPerSecond(const string& text, Scan scan, size_t& count) {
+    auto start = chrono::steady_clock::now();
+    count = scan();
+    double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return static_cast<double>(text.size()) / s / 1e9;
+}
+
+} // namespace
+
+int main() {
+    string text = makeLog(256 * 1024 * 1024);
+    cout << "Texte : " << text.size() / (1024 * 1024) << " Mio" << endl;
+
+    size_t count;
+    double ref = gbPerSecond(text, [&text]() {
+        return memchr(text.data(), '#', text.size()) == nullptr ? size_t(0) : size_t(1);
+    }, count);
+    cout << "memchr (octet absent, " << count << " trouve) : " << ref << " Go/s" << endl;
+
+    for (const char* regex : {"ERROR [0-9]+", "[EFG]RR(OR|Q)", "[A-Z][A-Z]+ [0-9]+"}) {
+        Searcher searcher(glushkov(regex));
+        double speed = gbPerSecond(text, [&]() { return searcher.findAll(text).size(); }, count);
+        cout << regex << " (prefiltre " << searcher.prefilter() << ") : " << count
+             << " occurrences, " << speed << " Go/s" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Compare Matcher (Shift-And bit-parallèle) à DfaTable sur le déterminisé
+// et à appartient() sur l'automate d'origine, en temps par octet lu :
+//  - automates de Glushkov de (a|b)*a(a|b)...(a|b), dont le déterminisé
+//    double à chaque (a|b) ajouté : 64 états pour 5, 8192 pour 12 ;
+//  - recherche de mots-clés, de 58 à environ 250 états (un, deux et quatre
+//    mots machine), dont le déterminisé reste petit ;
+//  - un automate non déterministe aléatoire, dont les transitions
+//    entrant dans un même état portent des lettres différentes.
+// Les mots lus ne sont jamais rejetés avant la fin : l'ensemble d'états
+// courant ne se vide pas, chaque octet est bien traité.
+
+#include "dfatable.h"
+#include "operations.h"
+#include "regex.h"
+#include "shiftand.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+vector<string> makeInputs(size_t count, size_t length, const string& letters, mt19937& rng) {
+    vector<string> inputs;
+    for (size_t i = 0; i < count; ++i) {
+        string w;
+        for (size_t k = 0; k < length; ++k) {
+            w += letters[rng() % letters.size()];
+        }
+        inputs.push_back(w);
+    }
+    return inputs;
+}
+
+// (a|b)*a suivi de n fois (a|b) : la n+1-ième lettre avant la fin est un a
+string suffixRegex(int n) {
+    string regex = "(a|b)*a";
+    for (int i = 0; i < n; ++i) {
+        regex += "(a|b)";
+    }
+    return regex;
+}
+
+// Recherche de mots-clés : (a|b|c|d)*(mot1|mot2|...), les mots étant
+// ajoutés jusqu'à totaliser au moins positions lettres
+string keywordRegex(size_t positions, mt19937& rng) {
+    string regex = "(a|b|c|d)*(";
+    size_t total = 4;
+    for (bool first = true; total < positions; first = false) {
+        string w;
+        for (int k = 0, n = 4 + rng() % 5; k < n; ++k) {
+            w += static_cast<char>('a' + rng() % 4);
+        }
+        regex += (first ? "" : "|") + w;
+        total += w.size();
+    }
+    return regex + ")";
+}
+
+Automaton randomNfa(int n, const string& letters, mt19937& rng) {
+    Automaton aut;
+    for (int i = 0; i < n; ++i) {
+        aut.newstate();
+    }
+    for (int q = 0; q < n; ++q) {
+        for (char c : letters) {
+            aut.add_trans_unchecked(q, c, rng() % n);
+            aut.add_trans_unchecked(q, c, q);
+        }
+    }
+    aut.add_init(0);
+    aut.add_final(n - 1);
+    return aut;
+}
+
+// Meilleur temps sur rounds passes, pour écarter les perturbations
+template <typename F>
+double nsPerByte(F appartient, const vector<string>& inputs, int rounds, size_t& accepted) {
+    size_t bytes = 0;
+    for (const string& w : inputs) {
+        bytes += w.size();
+    }
+    double best = 0;
+    for (int r = 0; r < rounds; ++r) {
+        accepted = 0;
+        auto start = chrono::steady_clock::now();
+        for (const string& w : inputs) {
+            accepted += appartient(w) ? 1 : 0;
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best / static_cast<double>(bytes);
+}
+
+bool compare(const string& name, const Automaton& aut, const vector<string>& inputs) {
+    Matcher matcher(aut);
+    DfaTable table(determinize(aut));
+    cout << name << " : " << aut.size() << " etats, Shift-And sur " << matcher.width()
+         << " bits, " << (matcher.homogeneous() ? "homogene" : "non homogene") << ", "
+         << table.size() << " etats deterministes" << endl;
+
+    // appartient() est trop lent pour toutes les entrées : un extrait
+    vector<string> sample(inputs.begin(), inputs.begin() + inputs.size() / 50);
+    size_t expected;
+    size_t accepted;
+    double reference = nsPerByte([&](const string& w) { return appartient(aut, w); }, sample, 1,
+                                 expected);
+    nsPerByte([&](const string& w) { return matcher.appartient(w); }, sample, 1, accepted);
+    if (accepted != expected) {
+        cerr << name << " : Matcher different de appartient" << endl;
+        return false;
+    }
+
+    const int rounds = 10;
+    double dense = nsPerByte([&](const string& w) { return table.appartient(w); }, inputs, rounds,
+                             expected);
+    double shiftAnd = nsPerByte([&](const string& w) { return matcher.appartient(w); }, inputs,
+                                rounds, accepted);
+    if (accepted != expected) {
+        cerr << name << " : Matcher different de DfaTable" << endl;
+        return false;
+    }
+    cout << "appartient : " << reference << " ns/octet, DfaTable : " << dense
+         << " ns/octet, Matcher : " << shiftAnd << " ns/octet (rapport a DfaTable "
+         << shiftAnd / dense << ")" << endl << endl;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    mt19937 rng(42);
+    vector<string> binary = makeInputs(20000, 64, "ab", rng);
+    vector<string> quaternary = makeInputs(20000, 64, "abcd", rng);
+
+    for (int n : {5, 12}) {
+        if (!compare(suffixRegex(n), glushkov(suffixRegex(n)), binary)) {
+            return 1;
+        }
+    }
+    for (size_t positions : {56, 116, 240}) {
+        if (!compare("Mots-cles, " + to_string(positions) + " lettres",
+                     glushkov(keywordRegex(positions, rng)), quaternary)) {
+            return 1;
+        }
+    }
+    if (!compare("NFA aleatoire", randomNfa(12, "abcd", rng), quaternary)) {
+        return 1;
+    }
+    return 0;
+}
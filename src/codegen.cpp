@@ -0,0 +1,83 @@
+#include "codegen.h"
+#include "dfatable.h"
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Intervalle [lo, hi] d'octets consécutifs menant au même état
+struct ByteRange {
+    int lo;
+    int hi;
+    int target;
+};
+
+// Intervalles des transitions sortantes de q, par octet croissant
+vector<ByteRange> ranges(const DfaTable& table, int q) {
+    vector<ByteRange> result;
+    for (int c = 0; c < 256; ++c) {
+        int target = table.next(q, static_cast<char>(c));
+        if (target < 0) {
+            continue;
+        }
+        if (!result.empty() && result.back().hi == c - 1 && result.back().target == target) {
+            result.back().hi = c;
+        } else {
+            result.push_back({c, c, target});
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void generateMatcher(const Automaton& dfa, const string& function, ostream& os) {
+    DfaTable table(dfa);
+
+    os << "// Matcher généré par generateMatcher() : ne pas modifier.\n"
+       << "#include <string_view>\n\n"
+       << "bool " << function << "(std::string_view word) {\n"
+       << "    const unsigned char* p = reinterpret_cast<const unsigned char*>(word.data());\n"
+       << "    const unsigned char* const end = p + word.size();\n"
+       << "    unsigned c;\n";
+    if (table.initial() < 0) {
+        os << "    (void)p;\n    (void)end;\n    (void)c;\n    return false;\n}\n";
+        return;
+    }
+    os << "    goto s" << table.initial() << ";\n";
+
+    for (int q = 0; q < table.size(); ++q) {
+        os << "s" << q << ":\n"
+           << "    if (p == end) {\n"
+           << "        return " << (table.is_final(q) ? "true" : "false") << ";\n"
+           << "    }\n"
+           << "    c = *p++;\n";
+
+        vector<ByteRange> singles;
+        for (const ByteRange& r : ranges(table, q)) {
+            if (r.hi - r.lo >= 2) {
+                // Un seul test non signé pour lo <= c <= hi
+                os << "    if (c - " << r.lo << "u <= " << (r.hi - r.lo) << "u) {\n"
+                   << "        goto s" << r.target << ";\n"
+                   << "    }\n";
+            } else {
+                singles.push_back(r);
+            }
+        }
+        if (!singles.empty()) {
+            os << "    switch (c) {\n";
+            for (const ByteRange& r : singles) {
+                for (int c = r.lo; c <= r.hi; ++c) {
+                    os << "    case " << c << ":\n";
+                }
+                os << "        goto s" << r.target << ";\n";
+            }
+            os << "    default:\n"
+               << "        break;\n"
+               << "    }\n";
+        }
+        os << "    return false;\n";
+    }
+    os << "}\n";
+}
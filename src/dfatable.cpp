@@ -0,0 +1,76 @@
+#include "dfatable.h"
+#include "renumber.h"
+#include <stdexcept>
+#include <tuple>
+
+using namespace std;
+
+DfaTable::DfaTable(const Automaton& aut)
+    : nb_states(aut.size()), init(-1),
+      delta(static_cast<size_t>(aut.size()) * 256, -1), finals(aut.size(), 0) {
+    if (aut.get_inits().size() > 1) {
+        throw invalid_argument("DfaTable : plusieurs états initiaux");
+    }
+    if (!aut.get_inits().is_empty()) {
+        init = aut.get_inits().at(0);
+    }
+    for (const auto& t : aut.get_trans()) {
+        int32_t& cell = delta[static_cast<size_t>(get<0>(t)) * 256
+                              + static_cast<unsigned char>(get<1>(t))];
+        if (cell >= 0 && cell != get<2>(t)) {
+            throw invalid_argument("DfaTable : automate non déterministe");
+        }
+        cell = get<2>(t);
+    }
+    for (int q : aut.get_finals()) {
+        finals[q] = 1;
+    }
+}
+
+int DfaTable::size() const {
+    return nb_states;
+}
+
+int DfaTable::initial() const {
+    return init;
+}
+
+bool DfaTable::appartient(const string& word) const {
+    int q = init;
+    if (q < 0) {
+        return false;
+    }
+    for (char c : word) {
+        q = next(q, c);
+        if (q < 0) {
+            return false;
+        }
+    }
+    return is_final(q);
+}
+
+MemoryUsage DfaTable::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("delta", delta);
+    usage.add_vector("finals", finals);
+    return usage;
+}
+
+void DfaTable::renumber(const vector<int>& order) {
+    vector<int> old2new = inversePermutation(order, nb_states);
+    vector<int32_t> newDelta(delta.size());
+    vector<uint8_t> newFinals(finals.size());
+    for (int i = 0; i < nb_states; ++i) {
+        const int32_t* row = &delta[static_cast<size_t>(order[i]) * 256];
+        int32_t* newRow = &newDelta[static_cast<size_t>(i) * 256];
+        for (int c = 0; c < 256; ++c) {
+            newRow[c] = row[c] < 0 ? -1 : old2new[row[c]];
+        }
+        newFinals[i] = finals[order[i]];
+    }
+    delta.swap(newDelta);
+    finals.swap(newFinals);
+    if (init >= 0) {
+        init = old2new[init];
+    }
+}
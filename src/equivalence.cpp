@@ -0,0 +1,180 @@
+#include "equivalence.h"
+#include "adjacency.h"
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+struct SubsetHash {
+    size_t operator()(const vector<int>& s) const {
+        size_t h = s.size();
+        for (int q : s) {
+            h = (h ^ static_cast<size_t>(q)) * 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+// Déterminisation paresseuse d'un automate : chaque ensemble d'états
+// rencontré reçoit un numéro de noeud global (partagé par les deux côtés).
+class LazySubsets {
+public:
+    LazySubsets(const Automaton& aut, vector<vector<int>>& succ, vector<bool>& accepting)
+        : adj(aut), final(aut.size(), false), succ(succ), accepting(accepting) {
+        for (int q : aut.get_finals()) {
+            final[q] = true;
+        }
+    }
+
+    // Numéro du noeud de l'ensemble trié s
+    int node(const vector<int>& s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(accepting.size());
+        ids.emplace(s, id);
+        bool acc = false;
+        for (int q : s) {
+            acc = acc || final[q];
+        }
+        accepting.push_back(acc);
+        succ.emplace_back();
+        subsets.emplace(id, s);
+        return id;
+    }
+
+    // Successeur par c de l'ensemble du noeud id
+    int next(int id, char c) {
+        vector<int> s;
+        for (int q : subsets.at(id)) {
+            auto range = adj.out(q, c);
+            for (const Adjacency::Edge* e = range.first; e != range.second; ++e) {
+                s.push_back(e->state);
+            }
+        }
+        sort(s.begin(), s.end());
+        s.erase(unique(s.begin(), s.end()), s.end());
+        return node(s);
+    }
+
+private:
+    Adjacency adj;
+    vector<bool> final;
+    unordered_map<vector<int>, int, SubsetHash> ids;
+    unordered_map<int, vector<int>> subsets;
+    vector<vector<int>>& succ;
+    vector<bool>& accepting;
+};
+
+int find(vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];  // Compression de chemin par division
+        x = parent[x];
+    }
+    return x;
+}
+
+} // namespace
+
+bool equivalent(const Automaton& aut1, const Automaton& aut2, string* witness) {
+    // Lettres étiquetant au moins une transition : les autres mènent à
+    // l'ensemble vide des deux côtés.
+    vector<char> letters;
+    for (const Automaton* aut : {&aut1, &aut2}) {
+        for (const auto& t : aut->get_trans()) {
+            letters.push_back(get<1>(t));
+        }
+    }
+    sort(letters.begin(), letters.end());
+    letters.erase(unique(letters.begin(), letters.end()), letters.end());
+
+    vector<vector<int>> succ;   // succ[noeud][indice de lettre], calculé à la demande
+    vector<bool> accepting;
+    LazySubsets side1(aut1, succ, accepting);
+    LazySubsets side2(aut2, succ, accepting);
+    LazySubsets* sides[2] = {&side1, &side2};
+    vector<int> side;           // côté de chaque noeud
+
+    auto sorted = [](const IdxSet<int>& set) {
+        vector<int> v(set.begin(), set.end());
+        sort(v.begin(), v.end());
+        return v;
+    };
+    auto onSide = [&](int s, int id) {
+        if (static_cast<size_t>(id) >= side.size()) {
+            side.resize(id + 1, s);
+        }
+        return id;
+    };
+    auto successor = [&](int x, size_t l) {
+        if (succ[x].empty()) {
+            succ[x].assign(letters.size(), -1);
+        }
+        if (succ[x][l] < 0) {
+            int s = side[x];
+            int y = onSide(s, sides[s]->next(x, letters[l]));
+            succ[x][l] = y;
+        }
+        return succ[x][l];
+    };
+
+    int init1 = onSide(0, side1.node(sorted(aut1.get_inits())));
+    int init2 = onSide(1, side2.node(sorted(aut2.get_inits())));
+
+    // Paires à comparer, en largeur, avec de quoi reconstruire le mot qui
+    // y mène : indice de la paire parente et lettre lue.
+    struct Pair {
+        int x;
+        int y;
+        int parent;
+        char letter;
+    };
+    vector<Pair> pairs;
+    deque<int> todo;
+    vector<int> parent;         // union-find sur les noeuds
+
+    pairs.push_back({init1, init2, -1, 0});
+    todo.push_back(0);
+    while (!todo.empty()) {
+        int p = todo.front();
+        todo.pop_front();
+        int x = pairs[p].x;
+        int y = pairs[p].y;
+        if (parent.size() < accepting.size()) {
+            size_t old = parent.size();
+            parent.resize(accepting.size());
+            for (size_t i = old; i < parent.size(); ++i) {
+                parent[i] = static_cast<int>(i);
+            }
+        }
+        int rx = find(parent, x);
+        int ry = find(parent, y);
+        if (rx == ry) {
+            continue;
+        }
+        if (accepting[x] != accepting[y]) {
+            if (witness) {
+                string w;
+                for (int i = p; pairs[i].parent >= 0; i = pairs[i].parent) {
+                    w.push_back(pairs[i].letter);
+                }
+                reverse(w.begin(), w.end());
+                *witness = w;
+            }
+            return false;
+        }
+        parent[rx] = ry;
+        for (size_t l = 0; l < letters.size(); ++l) {
+            int nx = successor(x, l);
+            int ny = successor(y, l);
+            pairs.push_back({nx, ny, p, letters[l]});
+            todo.push_back(static_cast<int>(pairs.size()) - 1);
+        }
+    }
+    return true;
+}
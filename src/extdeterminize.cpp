@@ -0,0 +1,618 @@
+#include "extdeterminize.h"
+#include "adjacency.h"
+#include "memusage.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+typedef vector<int> Subset;
+
+struct SubsetHash {
+    size_t operator()(const Subset& s) const {
+        size_t h = s.size();
+        for (int q : s) {
+            h = (h ^ static_cast<size_t>(q)) * 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+// Place approximative occupée en mémoire par une entrée de la table
+size_t entryBytes(const Subset& s) {
+    return s.size() * sizeof(int) + 96;
+}
+
+// Fichier binaire d'entiers, écrit séquentiellement
+class BinWriter {
+public:
+    BinWriter(const fs::path& path, size_t& bytes)
+        : out(path, ios::binary | ios::trunc), bytes(bytes) {}
+
+    void put(int32_t v) {
+        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+        bytes += sizeof(v);
+    }
+
+    void putSubset(const Subset& s) {
+        put(static_cast<int32_t>(s.size()));
+        out.write(reinterpret_cast<const char*>(s.data()), s.size() * sizeof(int));
+        bytes += s.size() * sizeof(int);
+    }
+
+    // Vide le tampon et ferme le fichier ; false si une écriture a échoué
+    bool close() {
+        out.close();
+        return static_cast<bool>(out);
+    }
+
+private:
+    ofstream out;
+    size_t& bytes;
+};
+
+// Lecture séquentielle d'un fichier écrit par BinWriter
+class BinReader {
+public:
+    explicit BinReader(const fs::path& path) : in(path, ios::binary) {}
+
+    bool get(int32_t& v) {
+        return read(&v, sizeof(v));
+    }
+
+    bool getSubset(Subset& s) {
+        int32_t n;
+        if (!get(n)) {
+            return false;
+        }
+        s.resize(n);
+        if (!read(s.data(), n * sizeof(int))) {
+            truncated = true;
+            return false;
+        }
+        return true;
+    }
+
+    // Lecture arrêtée au milieu d'un entier ou d'un sous-ensemble, ou
+    // erreur du flux, plutôt qu'à la fin du fichier
+    bool failed() const {
+        return truncated || in.bad();
+    }
+
+private:
+    ifstream in;
+    bool truncated = false;
+
+    bool read(void* data, size_t n) {
+        if (in.read(static_cast<char*>(data), n)) {
+            return true;
+        }
+        truncated = truncated || in.gcount() != 0;
+        return false;
+    }
+};
+
+// Transition candidate src -letter-> subset, dont la destination n'a pas
+// encore de numéro
+struct Candidate {
+    Subset subset;
+    int src;
+    char letter;
+
+    bool operator<(const Candidate& other) const {
+        return tie(subset, src, letter) < tie(other.subset, other.src, other.letter);
+    }
+};
+
+// Passe triée de candidats relue pendant la fusion
+class RunReader {
+public:
+    explicit RunReader(const fs::path& path) : in(path) {
+        advance();
+    }
+
+    bool valid() const {
+        return ok;
+    }
+
+    const Candidate& current() const {
+        return cand;
+    }
+
+    void advance() {
+        int32_t src, letter;
+        bool started = in.getSubset(cand.subset);
+        ok = started && in.get(src) && in.get(letter);
+        truncated = truncated || (started && !ok);
+        cand.src = src;
+        cand.letter = static_cast<char>(letter);
+    }
+
+    bool failed() const {
+        return truncated || in.failed();
+    }
+
+private:
+    BinReader in;
+    Candidate cand;
+    bool ok = false;
+    bool truncated = false;
+};
+
+// Table triée (sous-ensemble, numéro) lue séquentiellement
+class TableReader {
+public:
+    explicit TableReader(const fs::path& path) : in(path) {
+        advance();
+    }
+
+    bool valid() const {
+        return ok;
+    }
+
+    const Subset& subset() const {
+        return s;
+    }
+
+    int id() const {
+        return num;
+    }
+
+    void advance() {
+        int32_t n;
+        bool started = in.getSubset(s);
+        ok = started && in.get(n);
+        truncated = truncated || (started && !ok);
+        num = n;
+    }
+
+    bool failed() const {
+        return truncated || in.failed();
+    }
+
+private:
+    BinReader in;
+    Subset s;
+    int num = -1;
+    bool ok = false;
+    bool truncated = false;
+};
+
+// Répertoire temporaire supprimé avec son contenu à la destruction
+class TempDir {
+public:
+    explicit TempDir(const string& parent) {
+        fs::path base = parent.empty() ? fs::temp_directory_path() : fs::path(parent);
+        random_device rd;
+        do {
+            path = base / ("determinize-" + to_string(rd()));
+        } while (fs::exists(path));
+        fs::create_directories(path);
+    }
+
+    ~TempDir() {
+        error_code ec;
+        fs::remove_all(path, ec);
+    }
+
+    fs::path path;
+};
+
+class ExternalDeterminizer {
+public:
+    ExternalDeterminizer(const Automaton& aut, const DeterminizeBudget& budget,
+                         DeterminizeReport& report)
+        : aut(aut), budget(budget), report(report), adj(aut), final(aut.size(), false),
+          start(chrono::steady_clock::now()), next_id(0), memory(0) {
+        for (int q : aut.get_finals()) {
+            final[q] = true;
+        }
+        for (char c : aut.get_alphabet()) {
+            letters.push_back(c);
+        }
+    }
+
+    Automaton run() {
+        report = DeterminizeReport();
+        Automaton result = inMemory();
+        report.seconds = elapsed();
+        return result;
+    }
+
+private:
+    const Automaton& aut;
+    const DeterminizeBudget& budget;
+    DeterminizeReport& report;
+    Adjacency adj;
+    vector<bool> final;
+    vector<char> letters;
+    chrono::steady_clock::time_point start;
+    int next_id;
+    vector<int> finals;                 // États finaux de l'automate déterministe
+
+    // Phase en mémoire
+    unordered_map<Subset, int, SubsetHash> table;
+    vector<const Subset*> byId;
+    vector<tuple<int, char, int>> trans;
+    size_t memory;
+
+    // Phase en mémoire externe
+    unique_ptr<TempDir> dir;
+    size_t frontier_size = 0;
+
+    double elapsed() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Vérifie les limites strictes ; en cas de dépassement, renseigne le
+    // statut du compte rendu.
+    bool limitReached() {
+        report.nb_states = next_id;
+        if (budget.max_seconds > 0 && elapsed() > budget.max_seconds) {
+            report.status = DeterminizeReport::TimeLimit;
+        } else if (budget.max_states > 0 && static_cast<size_t>(next_id) > budget.max_states) {
+            report.status = DeterminizeReport::StateLimit;
+        } else if (budget.max_disk_bytes > 0 && report.disk_bytes > budget.max_disk_bytes) {
+            report.status = DeterminizeReport::DiskLimit;
+        }
+        return report.status != DeterminizeReport::Complete;
+    }
+
+    // Fichier temporaire mal écrit ou mal relu : arrêt du calcul
+    Automaton ioError() {
+        report.nb_states = next_id;
+        report.status = DeterminizeReport::IoError;
+        return Automaton();
+    }
+
+    Subset successor(const Subset& s, char c) const {
+        Subset next;
+        for (int q : s) {
+            auto range = adj.out(q, c);
+            for (const Adjacency::Edge* e = range.first; e != range.second; ++e) {
+                next.push_back(e->state);
+            }
+        }
+        sort(next.begin(), next.end());
+        next.erase(unique(next.begin(), next.end()), next.end());
+        return next;
+    }
+
+    // Attribue le numéro suivant au sous-ensemble s, nouveau
+    int newState(const Subset& s) {
+        int id = next_id++;
+        for (int q : s) {
+            if (final[q]) {
+                finals.push_back(id);
+                break;
+            }
+        }
+        return id;
+    }
+
+    int intern(const Subset& s) {
+        auto it = table.find(s);
+        if (it != table.end()) {
+            return it->second;
+        }
+        int id = newState(s);
+        auto inserted = table.emplace(s, id).first;
+        byId.push_back(&inserted->first);
+        memory += entryBytes(s);
+        return id;
+    }
+
+    Automaton inMemory() {
+        Subset init(aut.get_inits().begin(), aut.get_inits().end());
+        sort(init.begin(), init.end());
+        intern(init);
+
+        for (size_t i = 0; i < byId.size(); ++i) {
+            if (limitReached()) {
+                return Automaton();
+            }
+            for (char c : letters) {
+                Subset next = successor(*byId[i], c);
+                if (!next.empty()) {
+                    trans.emplace_back(static_cast<int>(i), c, intern(next));
+                    memory += sizeof(trans.back());
+                }
+            }
+            ++report.nb_expanded;
+            if (memory > budget.memory_bytes && i + 1 < byId.size()) {
+                if (!spill(i + 1)) {
+                    return ioError();
+                }
+                return external();
+            }
+        }
+
+        report.nb_transitions = trans.size();
+        Automaton det = build();
+        for (const auto& t : trans) {
+            det.add_trans_unchecked(get<0>(t), get<1>(t), get<2>(t));
+        }
+        return det;
+    }
+
+    // Écrit sur disque la table des sous-ensembles (triée), ceux qui
+    // restent à traiter à partir de first, et les transitions déjà
+    // trouvées, puis libère la mémoire correspondante. Retourne false si
+    // une écriture a échoué.
+    bool spill(size_t first) {
+        report.spilled = true;
+        dir.reset(new TempDir(budget.tmp_dir));
+
+        vector<pair<const Subset*, int>> sorted;
+        sorted.reserve(table.size());
+        for (const auto& entry : table) {
+            sorted.emplace_back(&entry.first, entry.second);
+        }
+        sort(sorted.begin(), sorted.end(),
+             [](const pair<const Subset*, int>& a, const pair<const Subset*, int>& b) {
+                 return *a.first < *b.first;
+             });
+        {
+            BinWriter v(dir->path / "table", report.disk_bytes);
+            for (const auto& entry : sorted) {
+                v.putSubset(*entry.first);
+                v.put(entry.second);
+            }
+            if (!v.close()) {
+                return false;
+            }
+        }
+        {
+            BinWriter f(dir->path / "frontier", report.disk_bytes);
+            for (size_t i = first; i < byId.size(); ++i) {
+                f.put(static_cast<int32_t>(i));
+                f.putSubset(*byId[i]);
+            }
+            frontier_size = byId.size() - first;
+            if (!f.close()) {
+                return false;
+            }
+        }
+        {
+            BinWriter t(dir->path / "transitions", report.disk_bytes);
+            for (const auto& tr : trans) {
+                t.put(get<0>(tr));
+                t.put(get<1>(tr));
+                t.put(get<2>(tr));
+            }
+            if (!t.close()) {
+                return false;
+            }
+        }
+        report.nb_transitions = trans.size();
+        unordered_map<Subset, int, SubsetHash>().swap(table);
+        vector<const Subset*>().swap(byId);
+        vector<tuple<int, char, int>>().swap(trans);
+        return true;
+    }
+
+    // Retourne false si l'écriture de la passe a échoué
+    bool flushRun(vector<Candidate>& buffer, size_t& bufferBytes, vector<fs::path>& runs) {
+        sort(buffer.begin(), buffer.end());
+        runs.push_back(dir->path / ("run" + to_string(runs.size())));
+        BinWriter w(runs.back(), report.disk_bytes);
+        for (const Candidate& c : buffer) {
+            w.putSubset(c.subset);
+            w.put(c.src);
+            w.put(c.letter);
+        }
+        ++report.nb_runs;
+        buffer.clear();
+        bufferBytes = 0;
+        return w.close();
+    }
+
+    Automaton external() {
+        // Les transitions sont ajoutées à la fin du fichier existant
+        fs::path tpath = dir->path / "transitions";
+
+        while (frontier_size > 0) {
+            // 1. Successeurs du niveau courant, en passes triées
+            vector<fs::path> runs;
+            vector<Candidate> buffer;
+            size_t bufferBytes = 0;
+            {
+                BinReader frontier(dir->path / "frontier");
+                int32_t id;
+                Subset s;
+                while (frontier.get(id)) {
+                    if (!frontier.getSubset(s)) {
+                        return ioError();
+                    }
+                    if (limitReached()) {
+                        return Automaton();
+                    }
+                    for (char c : letters) {
+                        Subset next = successor(s, c);
+                        if (!next.empty()) {
+                            bufferBytes += entryBytes(next);
+                            buffer.push_back({std::move(next), id, c});
+                        }
+                    }
+                    ++report.nb_expanded;
+                    if (bufferBytes > budget.memory_bytes / 2
+                        && !flushRun(buffer, bufferBytes, runs)) {
+                        return ioError();
+                    }
+                }
+                if (frontier.failed()) {
+                    return ioError();
+                }
+            }
+            if (!buffer.empty() && !flushRun(buffer, bufferBytes, runs)) {
+                return ioError();
+            }
+
+            // 2. Fusion des passes, confrontée à la table triée
+            frontier_size = 0;
+            {
+                vector<unique_ptr<RunReader>> readers;
+                for (const fs::path& p : runs) {
+                    readers.emplace_back(new RunReader(p));
+                }
+                auto greater = [&readers](size_t a, size_t b) {
+                    return readers[b]->current() < readers[a]->current();
+                };
+                priority_queue<size_t, vector<size_t>, decltype(greater)> heap(greater);
+                for (size_t r = 0; r < readers.size(); ++r) {
+                    if (readers[r]->valid()) {
+                        heap.push(r);
+                    }
+                }
+
+                TableReader known(dir->path / "table");
+                BinWriter added(dir->path / "added", report.disk_bytes);
+                BinWriter nextFrontier(dir->path / "frontier.next", report.disk_bytes);
+                ofstream tout(tpath, ios::binary | ios::app);
+                size_t tbytes = 0;
+
+                Subset group;
+                int groupId = -1;
+                while (!heap.empty()) {
+                    size_t r = heap.top();
+                    heap.pop();
+                    const Candidate& c = readers[r]->current();
+                    if (groupId < 0 || c.subset != group) {
+                        group = c.subset;
+                        while (known.valid() && known.subset() < group) {
+                            known.advance();
+                        }
+                        if (known.valid() && known.subset() == group) {
+                            groupId = known.id();
+                        } else {
+                            groupId = newState(group);
+                            added.putSubset(group);
+                            added.put(groupId);
+                            nextFrontier.put(groupId);
+                            nextFrontier.putSubset(group);
+                            ++frontier_size;
+                        }
+                    }
+                    int32_t rec[3] = {c.src, c.letter, groupId};
+                    tout.write(reinterpret_cast<const char*>(rec), sizeof(rec));
+                    tbytes += sizeof(rec);
+                    ++report.nb_transitions;
+
+                    readers[r]->advance();
+                    if (readers[r]->valid()) {
+                        heap.push(r);
+                    }
+                }
+                report.disk_bytes += tbytes;
+                tout.close();
+                bool readOk = !known.failed();
+                for (const auto& reader : readers) {
+                    readOk = readOk && !reader->failed();
+                }
+                if (!readOk || !tout || !added.close() || !nextFrontier.close()) {
+                    return ioError();
+                }
+            }
+            error_code ec;
+            for (const fs::path& p : runs) {
+                fs::remove(p, ec);
+            }
+            if (limitReached()) {
+                return Automaton();
+            }
+
+            // 3. Nouvelle table triée : fusion de l'ancienne et des ajouts
+            {
+                TableReader a(dir->path / "table");
+                TableReader b(dir->path / "added");
+                BinWriter merged(dir->path / "table.next", report.disk_bytes);
+                while (a.valid() || b.valid()) {
+                    TableReader& smallest =
+                        !b.valid() || (a.valid() && a.subset() < b.subset()) ? a : b;
+                    merged.putSubset(smallest.subset());
+                    merged.put(smallest.id());
+                    smallest.advance();
+                }
+                if (a.failed() || b.failed() || !merged.close()) {
+                    return ioError();
+                }
+            }
+            fs::rename(dir->path / "table.next", dir->path / "table", ec);
+            if (!ec) {
+                fs::rename(dir->path / "frontier.next", dir->path / "frontier", ec);
+            }
+            if (ec) {
+                return ioError();
+            }
+            fs::remove(dir->path / "added", ec);
+        }
+
+        Automaton det = build();
+        BinReader tin(tpath);
+        int32_t src, c, dst;
+        while (tin.get(src)) {
+            if (!tin.get(c) || !tin.get(dst)) {
+                return ioError();
+            }
+            det.add_trans_unchecked(src, static_cast<char>(c), dst);
+        }
+        if (tin.failed()) {
+            return ioError();
+        }
+        return det;
+    }
+
+    // Automate réduit à ses états, son état initial et ses états finaux
+    Automaton build() {
+        report.nb_states = next_id;
+        Automaton det;
+        for (int q = 0; q < next_id; ++q) {
+            det.newstate();
+        }
+        det.add_init(0);
+        for (int q : finals) {
+            det.add_final_unchecked(q);
+        }
+        return det;
+    }
+};
+
+} // namespace
+
+string DeterminizeReport::summary() const {
+    static const char* names[] = {"terminee", "limite de temps atteinte",
+                                  "limite d'etats atteinte", "limite disque atteinte",
+                                  "interrompue par une erreur d'entree/sortie"};
+    ostringstream os;
+    os << "Determinisation " << names[status] << " : " << nb_states << " etats ("
+       << nb_expanded << " traites), " << nb_transitions << " transitions, "
+       << seconds << " s";
+    if (spilled) {
+        os << ", " << nb_runs << " passes sur disque, " << disk_bytes << " octets ecrits";
+    }
+    if (peak_bytes > 0) {
+        os << ", pic memoire " << formatBytes(peak_bytes);
+    }
+    return os.str();
+}
+
+Automaton determinize(const Automaton& aut, const DeterminizeBudget& budget,
+                      DeterminizeReport& report) {
+    PeakMemoryScope scope;
+    Automaton result = ExternalDeterminizer(aut, budget, report).run();
+    report.peak_bytes = scope.peak();
+    return result;
+}
@@ -0,0 +1,101 @@
+#include "frozen.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+FrozenAutomaton::FrozenAutomaton(const Automaton& aut)
+    : adj(aut),
+      inits(aut.get_inits().begin(), aut.get_inits().end()),
+      alphabet(aut.get_alphabet().begin(), aut.get_alphabet().end()),
+      finals(aut.size(), false) {
+    sort(inits.begin(), inits.end());
+    sort(alphabet.begin(), alphabet.end());
+    for (int q : aut.get_finals()) {
+        finals[q] = true;
+    }
+}
+
+int FrozenAutomaton::size() const {
+    return adj.size();
+}
+
+const vector<int>& FrozenAutomaton::get_inits() const {
+    return inits;
+}
+
+const vector<char>& FrozenAutomaton::get_alphabet() const {
+    return alphabet;
+}
+
+bool FrozenAutomaton::is_final(int q) const {
+    return q >= 0 && q < size() && finals[q];
+}
+
+const Adjacency::Edge* FrozenAutomaton::out_begin(int q) const {
+    return adj.out_begin(q);
+}
+
+const Adjacency::Edge* FrozenAutomaton::out_end(int q) const {
+    return adj.out_end(q);
+}
+
+pair<const Adjacency::Edge*, const Adjacency::Edge*> FrozenAutomaton::out_states(int q, char c) const {
+    return adj.out(q, c);
+}
+
+bool FrozenAutomaton::appartient(const string& word) const {
+    // Ensembles d'états locaux à l'appel : aucune donnée partagée n'est
+    // modifiée.
+    vector<int> current = inits;
+    vector<int> next;
+    for (char c : word) {
+        next.clear();
+        for (int q : current) {
+            auto range = adj.out(q, c);
+            for (const Adjacency::Edge* e = range.first; e != range.second; ++e) {
+                next.push_back(e->state);
+            }
+        }
+        if (next.empty()) {
+            return false;
+        }
+        sort(next.begin(), next.end());
+        next.erase(unique(next.begin(), next.end()), next.end());
+        current.swap(next);
+    }
+    for (int q : current) {
+        if (finals[q]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MemoryUsage FrozenAutomaton::memory_usage() const {
+    MemoryUsage usage;
+    usage.add("adj", adj.memory_usage());
+    usage.add_vector("inits", inits);
+    usage.add_vector("alphabet", alphabet);
+    usage.add_vector("finals", finals);
+    return usage;
+}
+
+shared_ptr<const FrozenAutomaton> freeze(const Automaton& aut) {
+    return make_shared<const FrozenAutomaton>(aut);
+}
+
+FrozenSlot::FrozenSlot(shared_ptr<const FrozenAutomaton> snapshot)
+    : current(std::move(snapshot)) {}
+
+shared_ptr<const FrozenAutomaton> FrozenSlot::load() const {
+    return atomic_load(&current);
+}
+
+void FrozenSlot::store(shared_ptr<const FrozenAutomaton> snapshot) {
+    atomic_store(&current, std::move(snapshot));
+}
+
+shared_ptr<const FrozenAutomaton> FrozenSlot::exchange(shared_ptr<const FrozenAutomaton> snapshot) {
+    return atomic_exchange(&current, std::move(snapshot));
+}
@@ -0,0 +1,332 @@
+#include "graphmodel.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+using namespace std;
+
+GraphModel::GraphModel(const Automaton& aut)
+    : adj(aut), inits(aut.size(), false), finals(aut.size(), false),
+      comp(aut.size(), -1) {
+    for (int q : aut.get_inits()) {
+        inits[q] = true;
+    }
+    for (int q : aut.get_finals()) {
+        finals[q] = true;
+    }
+
+    // Tarjan itératif : la pile d'appels garde l'état et sa prochaine
+    // transition sortante à examiner
+    int n = aut.size();
+    vector<int> index(n, -1);
+    vector<int> low(n, 0);
+    vector<bool> onStack(n, false);
+    vector<int> stack;
+    vector<pair<int, const Adjacency::Edge*>> calls;
+    int counter = 0;
+    auto visit = [&](int v) {
+        index[v] = low[v] = counter++;
+        stack.push_back(v);
+        onStack[v] = true;
+        calls.emplace_back(v, adj.out_begin(v));
+    };
+    for (int s = 0; s < n; ++s) {
+        if (index[s] >= 0) {
+            continue;
+        }
+        visit(s);
+        while (!calls.empty()) {
+            int v = calls.back().first;
+            const Adjacency::Edge* e = calls.back().second;
+            if (e != adj.out_end(v)) {
+                calls.back().second = e + 1;
+                int w = e->state;
+                if (index[w] < 0) {
+                    visit(w);
+                } else if (onStack[w]) {
+                    low[v] = min(low[v], index[w]);
+                }
+                continue;
+            }
+            calls.pop_back();
+            if (low[v] == index[v]) {
+                int c = static_cast<int>(compSize.size());
+                compSize.push_back(0);
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    comp[w] = c;
+                    ++compSize[c];
+                } while (w != v);
+            }
+            if (!calls.empty()) {
+                int u = calls.back().first;
+                low[u] = min(low[u], low[v]);
+            }
+        }
+    }
+}
+
+int GraphModel::size() const {
+    return adj.size();
+}
+
+const Adjacency& GraphModel::adjacency() const {
+    return adj;
+}
+
+bool GraphModel::is_init(int q) const {
+    return inits[q];
+}
+
+bool GraphModel::is_final(int q) const {
+    return finals[q];
+}
+
+int GraphModel::first_init() const {
+    auto it = find(inits.begin(), inits.end(), true);
+    return it == inits.end() ? 0 : static_cast<int>(it - inits.begin());
+}
+
+int GraphModel::component(int q) const {
+    return comp[q];
+}
+
+int GraphModel::nb_components() const {
+    return static_cast<int>(compSize.size());
+}
+
+int GraphModel::component_size(int c) const {
+    return compSize[c];
+}
+
+vector<int> GraphModel::neighbourhood(int center, int radius, size_t maxStates,
+                                      vector<int>* distances) const {
+    vector<int> order;
+    vector<int> dist;
+    if (center < 0 || center >= size() || maxStates == 0) {
+        if (distances != nullptr) {
+            distances->clear();
+        }
+        return order;
+    }
+    // Distances des états déjà vus ; map pour ne pas allouer size() entiers
+    // à chaque voisinage demandé
+    map<int, int> seen;
+    order.push_back(center);
+    dist.push_back(0);
+    seen[center] = 0;
+    for (size_t head = 0; head < order.size() && order.size() < maxStates; ++head) {
+        int q = order[head];
+        if (dist[head] >= radius) {
+            break;
+        }
+        auto expand = [&](const Adjacency::Edge* begin, const Adjacency::Edge* end) {
+            for (const Adjacency::Edge* e = begin; e != end && order.size() < maxStates; ++e) {
+                if (seen.emplace(e->state, dist[head] + 1).second) {
+                    order.push_back(e->state);
+                    dist.push_back(dist[head] + 1);
+                }
+            }
+        };
+        expand(adj.out_begin(q), adj.out_end(q));
+        expand(adj.in_begin(q), adj.in_end(q));
+    }
+    if (distances != nullptr) {
+        distances->swap(dist);
+    }
+    return order;
+}
+
+GraphLayout layoutNeighbourhood(const GraphModel& model, int center, int radius,
+                                size_t maxStates, size_t collapseThreshold,
+                                const vector<int>& expanded) {
+    GraphLayout layout;
+    layout.center = center;
+    vector<int> distances;
+    vector<int> states = model.neighbourhood(center, radius, maxStates, &distances);
+    const Adjacency& adj = model.adjacency();
+
+    // Noeud de chaque état affiché ; clé -1 - c pour une composante repliée
+    map<int, int> nodeOf;
+    map<int, int> stateNode;
+    vector<int> layerOf;
+    for (size_t i = 0; i < states.size(); ++i) {
+        int q = states[i];
+        int c = model.component(q);
+        bool collapse = static_cast<size_t>(model.component_size(c)) > collapseThreshold
+                        && find(expanded.begin(), expanded.end(), c) == expanded.end();
+        int key = collapse ? -1 - c : q;
+        auto it = nodeOf.find(key);
+        if (it == nodeOf.end()) {
+            it = nodeOf.emplace(key, static_cast<int>(layout.nodes.size())).first;
+            layout.nodes.push_back({collapse ? -1 : q, c, collapse ? model.component_size(c) : 1,
+                                    false, false, false, 0, 0});
+            layerOf.push_back(distances[i]);
+        }
+        GraphNode& node = layout.nodes[it->second];
+        node.init = node.init || model.is_init(q);
+        node.final = node.final || model.is_final(q);
+        stateNode[q] = it->second;
+    }
+
+    // Arcs regroupés par couple de noeuds ; bords du voisinage
+    map<pair<int, int>, vector<char>> letters;
+    for (int q : states) {
+        int from = stateNode[q];
+        for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+            auto it = stateNode.find(e->state);
+            if (it == stateNode.end()) {
+                layout.nodes[from].frontier = true;
+                continue;
+            }
+            if (it->second == from && layout.nodes[from].state < 0) {
+                continue;   // Transition interne à une composante repliée
+            }
+            letters[make_pair(from, it->second)].push_back(e->letter);
+        }
+        for (const Adjacency::Edge* e = adj.in_begin(q); e != adj.in_end(q); ++e) {
+            if (stateNode.find(e->state) == stateNode.end()) {
+                layout.nodes[from].frontier = true;
+            }
+        }
+    }
+    for (auto& l : letters) {
+        layout.edges.push_back({l.first.first, l.first.second, letterLabel(l.second)});
+    }
+
+    // Couches par distance ; dans une couche, ordre par barycentre des
+    // voisins de la couche précédente pour limiter les croisements
+    // Les couches vidées par le repliement sont supprimées
+    vector<int> used = layerOf;
+    sort(used.begin(), used.end());
+    used.erase(unique(used.begin(), used.end()), used.end());
+    for (int& l : layerOf) {
+        l = static_cast<int>(lower_bound(used.begin(), used.end(), l) - used.begin());
+    }
+    int nbLayers = static_cast<int>(used.size());
+    vector<vector<int>> layers(nbLayers);
+    for (size_t v = 0; v < layout.nodes.size(); ++v) {
+        layers[layerOf[v]].push_back(static_cast<int>(v));
+    }
+    vector<double> rank(layout.nodes.size(), 0);
+    const double dx = 180;
+    const double dy = 80;
+    for (int l = 0; l < nbLayers; ++l) {
+        vector<double> sum(layout.nodes.size(), 0);
+        vector<int> count(layout.nodes.size(), 0);
+        if (l > 0) {
+            for (const GraphEdge& e : layout.edges) {
+                int a = e.from;
+                int b = e.to;
+                if (layerOf[a] == l && layerOf[b] == l - 1) {
+                    swap(a, b);
+                }
+                if (layerOf[a] == l - 1 && layerOf[b] == l) {
+                    sum[b] += rank[a];
+                    ++count[b];
+                }
+            }
+        }
+        vector<int>& layer = layers[l];
+        stable_sort(layer.begin(), layer.end(), [&](int a, int b) {
+            double ra = count[a] > 0 ? sum[a] / count[a] : 1e18;
+            double rb = count[b] > 0 ? sum[b] / count[b] : 1e18;
+            return ra < rb;
+        });
+        for (size_t i = 0; i < layer.size(); ++i) {
+            GraphNode& node = layout.nodes[layer[i]];
+            rank[layer[i]] = static_cast<double>(i);
+            node.x = l * dx;
+            node.y = (static_cast<double>(i) - (layer.size() - 1) / 2.0) * dy;
+        }
+    }
+    return layout;
+}
+
+namespace {
+
+string letterString(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    if (u > 32 && u < 127 && c != '\\' && c != ',' && c != '-') {
+        return string(1, c);
+    }
+    char buf[8];
+    snprintf(buf, sizeof(buf), "\\x%02X", u);
+    return buf;
+}
+
+// Chaîne entre guillemets du format DOT
+string dotQuote(const string& s) {
+    string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+string letterLabel(vector<char> letters) {
+    vector<int> codes;
+    for (char c : letters) {
+        codes.push_back(static_cast<unsigned char>(c));
+    }
+    sort(codes.begin(), codes.end());
+    codes.erase(unique(codes.begin(), codes.end()), codes.end());
+    string label;
+    for (size_t i = 0; i < codes.size();) {
+        size_t j = i;
+        while (j + 1 < codes.size() && codes[j + 1] == codes[j] + 1) {
+            ++j;
+        }
+        if (!label.empty()) {
+            label += ",";
+        }
+        label += letterString(static_cast<char>(codes[i]));
+        if (j >= i + 2) {
+            label += "-" + letterString(static_cast<char>(codes[j]));
+        } else if (j == i + 1) {
+            label += "," + letterString(static_cast<char>(codes[j]));
+        }
+        i = j + 1;
+    }
+    return label;
+}
+
+void writeDot(const Automaton& aut, ostream& os) {
+    Adjacency adj(aut);
+    os << "digraph automate {\n"
+       << "  rankdir=LR;\n"
+       << "  node [shape=circle];\n";
+    for (int q : aut.get_finals()) {
+        os << "  " << q << " [shape=doublecircle];\n";
+    }
+    for (int q : aut.get_inits()) {
+        os << "  init" << q << " [shape=point];\n"
+           << "  init" << q << " -> " << q << ";\n";
+    }
+    // Transitions de chaque état regroupées par destination
+    vector<pair<int, char>> out;
+    for (int q = 0; q < aut.size(); ++q) {
+        out.clear();
+        for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+            out.emplace_back(e->state, e->letter);
+        }
+        sort(out.begin(), out.end());
+        for (size_t i = 0; i < out.size();) {
+            int dst = out[i].first;
+            vector<char> letters;
+            for (; i < out.size() && out[i].first == dst; ++i) {
+                letters.push_back(out[i].second);
+            }
+            os << "  " << q << " -> " << dst << " [label=" << dotQuote(letterLabel(letters)) << "];\n";
+        }
+    }
+    os << "}\n";
+}
@@ -0,0 +1,177 @@
+#include "hybriddfa.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+HybridDfa::HybridDfa(const Automaton& aut, size_t denseBudget) : init(-1) {
+    if (aut.get_inits().size() > 1) {
+        throw invalid_argument("HybridDfa : plusieurs états initiaux");
+    }
+    if (!aut.get_inits().is_empty()) {
+        init = aut.get_inits().at(0);
+    }
+
+    // Transitions groupées par source, triées par lettre
+    vector<int> offsets(aut.size() + 1, 0);
+    for (const auto& t : aut.get_trans()) {
+        ++offsets[get<0>(t) + 1];
+    }
+    for (int q = 0; q < aut.size(); ++q) {
+        offsets[q + 1] += offsets[q];
+    }
+    vector<pair<uint8_t, int>> out(offsets.back());
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& t : aut.get_trans()) {
+        out[fill[get<0>(t)]++] = make_pair(static_cast<uint8_t>(get<1>(t)), get<2>(t));
+    }
+
+    vector<int> degree(aut.size());
+    for (int q = 0; q < aut.size(); ++q) {
+        auto begin = out.begin() + offsets[q];
+        auto end = out.begin() + offsets[q + 1];
+        sort(begin, end);
+        end = unique(begin, end);
+        for (auto it = begin; it + 1 < end; ++it) {
+            if (it->first == (it + 1)->first) {
+                throw invalid_argument("HybridDfa : automate non déterministe");
+            }
+        }
+        degree[q] = static_cast<int>(end - begin);
+    }
+
+    // Lignes denses obligatoires, puis budget restant réparti par nombre de
+    // transitions décroissant
+    const size_t rowBytes = 256 * sizeof(int32_t);
+    vector<bool> dense(aut.size(), false);
+    vector<int> candidates;
+    size_t spent = 0;
+    for (int q = 0; q < aut.size(); ++q) {
+        if (degree[q] > maxSparse) {
+            dense[q] = true;
+            spent += rowBytes;
+        } else if (degree[q] >= 2) {
+            candidates.push_back(q);
+        }
+    }
+    stable_sort(candidates.begin(), candidates.end(),
+                [&degree](int p, int q) { return degree[p] > degree[q]; });
+    for (int q : candidates) {
+        if (spent + rowBytes > denseBudget) {
+            break;
+        }
+        dense[q] = true;
+        spent += rowBytes;
+    }
+
+    // Position de chaque état, précédée de son numéro
+    vector<size_t> positions(aut.size());
+    size_t total = 0;
+    for (int q = 0; q < aut.size(); ++q) {
+        positions[q] = total + 1;
+        total += 1 + (dense[q] ? 256 : degree[q] <= 1 ? 2 : 4 + degree[q]);
+    }
+    if (total >= (size_t(1) << 28)) {
+        throw length_error("HybridDfa : automate trop grand");
+    }
+    handles.resize(aut.size());
+    for (int q = 0; q < aut.size(); ++q) {
+        Layout l = dense[q] ? Layout::Dense : degree[q] <= 1 ? Layout::Single : Layout::Sparse;
+        handles[q] = static_cast<int32_t>(positions[q] << 3) | static_cast<int32_t>(l);
+    }
+    for (int q : aut.get_finals()) {
+        handles[q] |= finalBit;
+    }
+
+    code.assign(total, -1);
+    for (int q = 0; q < aut.size(); ++q) {
+        auto begin = out.begin() + offsets[q];
+        auto end = begin + degree[q];
+        int32_t* s = &code[positions[q]];
+        s[-1] = q;
+        switch (static_cast<Layout>(handles[q] & layoutMask)) {
+        case Layout::Dense:
+            for (auto it = begin; it != end; ++it) {
+                s[it->first] = handles[it->second];
+            }
+            break;
+        case Layout::Single:
+            s[0] = begin == end ? 256 : begin->first;
+            s[1] = begin == end ? -1 : handles[begin->second];
+            break;
+        case Layout::Sparse: {
+            uint8_t* letters = reinterpret_cast<uint8_t*>(s);
+            for (int i = 0; i < maxSparse; ++i) {
+                letters[i] = i < degree[q] ? begin[i].first : begin[0].first;
+            }
+            for (int i = 0; i < degree[q]; ++i) {
+                s[4 + i] = handles[begin[i].second];
+            }
+            break;
+        }
+        }
+    }
+}
+
+int HybridDfa::size() const {
+    return static_cast<int>(handles.size());
+}
+
+int HybridDfa::initial() const {
+    return init;
+}
+
+bool HybridDfa::appartient(const string& word) const {
+    if (init < 0) {
+        return false;
+    }
+    int32_t h = handles[init];
+    for (char c : word) {
+        h = step(h, c);
+        if (h < 0) {
+            return false;
+        }
+    }
+    return (h & finalBit) != 0;
+}
+
+HybridDfa::Layout HybridDfa::layout(int q) const {
+    return static_cast<Layout>(handles[q] & layoutMask);
+}
+
+int HybridDfa::count(Layout l) const {
+    int n = 0;
+    for (int q = 0; q < size(); ++q) {
+        n += layout(q) == l ? 1 : 0;
+    }
+    return n;
+}
+
+MemoryUsage HybridDfa::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("handles", handles);
+    usage.add_vector("code", code);
+    return usage;
+}
+
+size_t HybridDfa::dense_bytes() const {
+    // delta (256 entiers par état) et finals (un octet par état)
+    return handles.size() * (256 * sizeof(int32_t) + sizeof(uint8_t));
+}
+
+string HybridDfa::report() const {
+    size_t used = memory_usage().used();
+    size_t dense = dense_bytes();
+    ostringstream os;
+    os << size() << " états : " << count(Layout::Single) << " Single, "
+       << count(Layout::Sparse) << " Sparse, " << count(Layout::Dense) << " Dense\n"
+       << formatBytes(used) << " contre " << formatBytes(dense) << " pour DfaTable";
+    if (dense > 0) {
+        os << " (économie de " << (100 * (dense - min(used, dense)) / dense) << " %)";
+    }
+    os << "\n";
+    return os.str();
+}
@@ -0,0 +1,449 @@
+#include "incremental.h"
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+size_t IncrementalDeterminizer::SubsetHash::operator()(const vector<int>& s) const {
+    size_t h = s.size();
+    for (int q : s) {
+        h = (h ^ static_cast<size_t>(q)) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+IncrementalDeterminizer::IncrementalDeterminizer() : IncrementalDeterminizer(Automaton()) {}
+
+namespace {
+
+// Nettoyage dès que le nombre de sous-ensembles internés atteint deux fois
+// celui des accessibles, et jamais en dessous de ce seuil
+const size_t minCompact = 1024;
+
+} // namespace
+
+IncrementalDeterminizer::IncrementalDeterminizer(const Automaton& nfa)
+    : automaton(nfa), out(nfa.size()), nfaFinal(nfa.size(), false), containing(nfa.size()),
+      nb_dead(0), compactAt(minCompact) {
+    for (const auto& t : nfa.get_trans()) {
+        out[get<0>(t)].emplace_back(get<1>(t), get<2>(t));
+    }
+    for (auto& edges : out) {
+        sort(edges.begin(), edges.end());
+    }
+    for (int q : nfa.get_finals()) {
+        nfaFinal[q] = true;
+    }
+
+    vector<int> initial(nfa.get_inits().begin(), nfa.get_inits().end());
+    sort(initial.begin(), initial.end());
+    vector<Pending> pending;
+    init = intern(initial, pending);
+    acquire(init);
+    explore(pending);
+    compactAt = max(2 * subsets.size(), minCompact);
+}
+
+void IncrementalDeterminizer::growNfa(int q) {
+    if (q >= static_cast<int>(out.size())) {
+        out.resize(q + 1);
+        nfaFinal.resize(q + 1, false);
+        containing.resize(q + 1);
+    }
+}
+
+int IncrementalDeterminizer::newstate() {
+    int q = automaton.newstate();
+    growNfa(q);
+    return q;
+}
+
+void IncrementalDeterminizer::add_init(int q) {
+    growNfa(q);
+    if (binary_search(subsets[init].begin(), subsets[init].end(), q)) {
+        return;
+    }
+    automaton.add_init(q);
+    vector<int> initial = subsets[init];
+    initial.insert(upper_bound(initial.begin(), initial.end(), q), q);
+    vector<Pending> pending;
+    int previous = init;
+    init = intern(initial, pending, previous, {q});
+    acquire(init);
+    explore(pending);
+    release(previous);
+    compactIfNeeded();
+}
+
+void IncrementalDeterminizer::add_trans(int src, char c, int dst) {
+    growNfa(max(src, dst));
+    pair<char, int> edge(c, dst);
+    auto pos = lower_bound(out[src].begin(), out[src].end(), edge);
+    if (pos != out[src].end() && *pos == edge) {
+        return;
+    }
+    out[src].insert(pos, edge);
+    automaton.add_trans_unchecked(src, c, dst);
+
+    // Les sous-ensembles créés pendant la boucle sont explorés après, avec
+    // la nouvelle transition : seuls les anciens sont à corriger. Les
+    // anciennes cibles ne sont relâchées qu'après l'exploration, qui
+    // dérive les transitions des nouvelles des leurs.
+    vector<Pending> pending;
+    vector<int> previous;
+    size_t affected = containing[src].size();
+    for (size_t i = 0; i < affected; ++i) {
+        int d = containing[src][i];
+        if (!alive[d]) {
+            continue;
+        }
+        int t = transition(d, c);
+        vector<int> target;
+        if (t >= 0) {
+            if (binary_search(subsets[t].begin(), subsets[t].end(), dst)) {
+                continue;
+            }
+            target = subsets[t];
+        }
+        target.insert(upper_bound(target.begin(), target.end(), dst), dst);
+        int replaced = setTransition(d, c, intern(target, pending, t, {dst}));
+        if (replaced >= 0) {
+            previous.push_back(replaced);
+        }
+    }
+    explore(pending);
+    for (int t : previous) {
+        release(t);
+    }
+    compactIfNeeded();
+}
+
+void IncrementalDeterminizer::add_final(int q) {
+    growNfa(q);
+    if (nfaFinal[q]) {
+        return;
+    }
+    nfaFinal[q] = true;
+    automaton.add_final_unchecked(q);
+    for (int d : containing[q]) {
+        finals[d] = finals[d] || alive[d];
+    }
+}
+
+const Automaton& IncrementalDeterminizer::nfa() const {
+    return automaton;
+}
+
+int IncrementalDeterminizer::nb_subsets() const {
+    return static_cast<int>(subsets.size() - nb_dead);
+}
+
+MemoryUsage IncrementalDeterminizer::memory_usage() const {
+    MemoryUsage usage;
+    usage.add("nfa", automaton.memory_usage());
+    size_t used = 0;
+    size_t reserved = 0;
+    for (const auto& edges : out) {
+        used += edges.size() * sizeof(edges[0]);
+        reserved += edges.capacity() * sizeof(edges[0]);
+    }
+    usage.add("out", used + out.size() * sizeof(out[0]), reserved + out.capacity() * sizeof(out[0]));
+    used = reserved = 0;
+    size_t keys = 0;
+    for (const auto& s : subsets) {
+        used += s.size() * sizeof(int);
+        reserved += s.capacity() * sizeof(int);
+    }
+    for (const auto& entry : ids) {
+        keys += entry.first.capacity() * sizeof(int);
+    }
+    usage.add("subsets", used + subsets.size() * sizeof(subsets[0]),
+              reserved + subsets.capacity() * sizeof(subsets[0]));
+    usage.add_hash_map("ids", ids);
+    usage.add("ids.cles", keys, keys);
+    used = reserved = 0;
+    for (const auto& row : delta) {
+        used += row.size() * sizeof(row[0]);
+        reserved += row.capacity() * sizeof(row[0]);
+    }
+    usage.add("delta", used + delta.size() * sizeof(delta[0]),
+              reserved + delta.capacity() * sizeof(delta[0]));
+    used = reserved = 0;
+    for (const auto& list : containing) {
+        used += list.size() * sizeof(int);
+        reserved += list.capacity() * sizeof(int);
+    }
+    usage.add("containing", used + containing.size() * sizeof(containing[0]),
+              reserved + containing.capacity() * sizeof(containing[0]));
+    usage.add_vector("refs", refs);
+    usage.add_vector("alive", alive);
+    usage.add_vector("finals", finals);
+    return usage;
+}
+
+int IncrementalDeterminizer::intern(const vector<int>& s, vector<Pending>& pending, int base,
+                                    const vector<int>& extra) {
+    auto it = ids.find(s);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(subsets.size());
+    bool final = false;
+    for (int q : s) {
+        containing[q].push_back(id);
+        final = final || nfaFinal[q];
+    }
+    subsets.push_back(s);
+    delta.emplace_back();
+    finals.push_back(final);
+    refs.push_back(0);
+    alive.push_back(true);
+    explored.push_back(false);
+    ids.emplace(s, id);
+    pending.push_back({id, base, extra});
+    return id;
+}
+
+void IncrementalDeterminizer::explore(vector<Pending>& pending) {
+    vector<pair<char, int>> edges;
+    while (!pending.empty()) {
+        Pending p = move(pending.back());
+        pending.pop_back();
+        int d = p.id;
+        if (!alive[d]) {
+            continue;
+        }
+        bool derived = p.base >= 0 && alive[p.base] && explored[p.base];
+
+        // Transitions des états à parcourir : tous ceux de d, ou seulement
+        // ceux qui s'ajoutent à base
+        edges.clear();
+        for (int q : derived ? p.extra : subsets[d]) {
+            edges.insert(edges.end(), out[q].begin(), out[q].end());
+        }
+        sort(edges.begin(), edges.end());
+        edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+        if (!derived) {
+            for (size_t i = 0; i < edges.size();) {
+                char c = edges[i].first;
+                vector<int> target;
+                for (; i < edges.size() && edges[i].first == c; ++i) {
+                    target.push_back(edges[i].second);
+                }
+                setTransition(d, c, intern(target, pending));
+            }
+        } else {
+            // Successeur par c : celui de base, plus les successeurs des
+            // états ajoutés qui n'y sont pas déjà
+            vector<pair<char, int>> row = delta[p.base];
+            size_t i = 0;
+            size_t k = 0;
+            while (i < row.size() || k < edges.size()) {
+                char c = k == edges.size() || (i < row.size() && row[i].first < edges[k].first)
+                             ? row[i].first
+                             : edges[k].first;
+                int u = i < row.size() && row[i].first == c ? row[i++].second : -1;
+                vector<int> target = u >= 0 ? subsets[u] : vector<int>();
+                vector<int> added;
+                for (; k < edges.size() && edges[k].first == c; ++k) {
+                    int q = edges[k].second;
+                    if (!binary_search(target.begin(), target.end(), q)) {
+                        added.push_back(q);
+                    }
+                }
+                if (added.empty()) {
+                    setTransition(d, c, u);
+                    continue;
+                }
+                vector<int> merged(target.size() + added.size());
+                merge(target.begin(), target.end(), added.begin(), added.end(), merged.begin());
+                setTransition(d, c, intern(merged, pending, u, added));
+            }
+        }
+        explored[d] = true;
+    }
+}
+
+int IncrementalDeterminizer::setTransition(int d, char c, int target) {
+    auto& row = delta[d];
+    auto pos = lower_bound(row.begin(), row.end(), c,
+                           [](const pair<char, int>& e, char l) { return e.first < l; });
+    acquire(target);
+    if (pos != row.end() && pos->first == c) {
+        int previous = pos->second;
+        pos->second = target;
+        return previous;
+    }
+    row.insert(pos, make_pair(c, target));
+    return -1;
+}
+
+void IncrementalDeterminizer::acquire(int d) {
+    ++refs[d];
+}
+
+void IncrementalDeterminizer::release(int d) {
+    // Pile explicite : une longue chaîne de sous-ensembles peut être
+    // libérée d'un coup
+    vector<int> freed;
+    if (--refs[d] == 0) {
+        freed.push_back(d);
+    }
+    while (!freed.empty()) {
+        int f = freed.back();
+        freed.pop_back();
+        alive[f] = false;
+        ++nb_dead;
+        ids.erase(subsets[f]);
+        vector<int>().swap(subsets[f]);
+        for (const auto& e : delta[f]) {
+            if (--refs[e.second] == 0) {
+                freed.push_back(e.second);
+            }
+        }
+        vector<pair<char, int>>().swap(delta[f]);
+        finals[f] = false;
+    }
+}
+
+void IncrementalDeterminizer::compactIfNeeded() {
+    if (subsets.size() < compactAt) {
+        return;
+    }
+    vector<int> order;
+    vector<int> number;
+    reachable(order, number);
+
+    vector<vector<int>> keptSubsets(order.size());
+    vector<vector<pair<char, int>>> keptDelta(order.size());
+    vector<bool> keptFinals(order.size());
+    vector<int> keptRefs(order.size(), 0);
+    for (size_t i = 0; i < order.size(); ++i) {
+        int d = order[i];
+        keptSubsets[i].swap(subsets[d]);
+        keptDelta[i].swap(delta[d]);
+        for (auto& e : keptDelta[i]) {
+            e.second = number[e.second];
+            ++keptRefs[e.second];
+        }
+        keptFinals[i] = finals[d];
+    }
+    subsets.swap(keptSubsets);
+    delta.swap(keptDelta);
+    finals.swap(keptFinals);
+    refs.swap(keptRefs);
+    alive.assign(order.size(), true);
+    explored.assign(order.size(), true);
+    init = 0;
+    ++refs[init];
+    nb_dead = 0;
+
+    ids.clear();
+    for (auto& list : containing) {
+        list.clear();
+    }
+    for (size_t i = 0; i < subsets.size(); ++i) {
+        ids.emplace(subsets[i], static_cast<int>(i));
+        for (int q : subsets[i]) {
+            containing[q].push_back(static_cast<int>(i));
+        }
+    }
+    compactAt = max(2 * subsets.size(), minCompact);
+}
+
+int IncrementalDeterminizer::transition(int d, char c) const {
+    const auto& row = delta[d];
+    auto pos = lower_bound(row.begin(), row.end(), c,
+                           [](const pair<char, int>& e, char l) { return e.first < l; });
+    return pos != row.end() && pos->first == c ? pos->second : -1;
+}
+
+bool IncrementalDeterminizer::appartient(const string& word) const {
+    int d = init;
+    for (char c : word) {
+        d = transition(d, c);
+        if (d < 0) {
+            return false;
+        }
+    }
+    return finals[d];
+}
+
+void IncrementalDeterminizer::reachable(vector<int>& order, vector<int>& number) const {
+    order.assign(1, init);
+    number.assign(subsets.size(), -1);
+    number[init] = 0;
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (const auto& e : delta[order[head]]) {
+            if (number[e.second] < 0) {
+                number[e.second] = static_cast<int>(order.size());
+                order.push_back(e.second);
+            }
+        }
+    }
+}
+
+Automaton IncrementalDeterminizer::dfa() const {
+    vector<int> order;
+    vector<int> number;
+    reachable(order, number);
+
+    Automaton result;
+    for (size_t i = 0; i < order.size(); ++i) {
+        result.newstate();
+    }
+    result.add_init(0);
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (const auto& e : delta[order[i]]) {
+            result.add_trans_unchecked(static_cast<int>(i), e.first, number[e.second]);
+        }
+        if (finals[order[i]]) {
+            result.add_final_unchecked(static_cast<int>(i));
+        }
+    }
+    return result;
+}
+
+Automaton IncrementalDeterminizer::complement() const {
+    vector<int> order;
+    vector<int> number;
+    reachable(order, number);
+
+    // Alphabet du déterminisé : lettres de ses transitions accessibles
+    vector<char> letters;
+    for (int d : order) {
+        for (const auto& e : delta[d]) {
+            letters.push_back(e.first);
+        }
+    }
+    sort(letters.begin(), letters.end());
+    letters.erase(unique(letters.begin(), letters.end()), letters.end());
+
+    Automaton result;
+    int n = static_cast<int>(order.size());
+    for (int i = 0; i < n; ++i) {
+        result.newstate();
+    }
+    result.add_init(0);
+    int sink = -1;
+    for (int i = 0; i < n; ++i) {
+        for (char c : letters) {
+            int t = transition(order[i], c);
+            if (t < 0 && sink < 0) {
+                sink = result.newstate();
+            }
+            result.add_trans_unchecked(i, c, t < 0 ? sink : number[t]);
+        }
+        if (!finals[order[i]]) {
+            result.add_final_unchecked(i);
+        }
+    }
+    if (sink >= 0) {
+        for (char c : letters) {
+            result.add_trans_unchecked(sink, c, sink);
+        }
+        result.add_final_unchecked(sink);
+    }
+    return result;
+}
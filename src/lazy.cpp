@@ -0,0 +1,525 @@
+#include "lazy.h"
+#include "adjacency.h"
+#include "operations.h"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+void sortUnique(vector<int>& v) {
+    sort(v.begin(), v.end());
+    v.erase(unique(v.begin(), v.end()), v.end());
+}
+
+void sortUnique(vector<char>& v) {
+    sort(v.begin(), v.end());
+    v.erase(unique(v.begin(), v.end()), v.end());
+}
+
+// Vecteurs d'états : les vecteurs eux-mêmes et leurs éléments
+size_t subsetsBytes(const vector<vector<int>>& subsets, bool capacity) {
+    size_t bytes = (capacity ? subsets.capacity() : subsets.size()) * sizeof(vector<int>);
+    for (const vector<int>& s : subsets) {
+        bytes += (capacity ? s.capacity() : s.size()) * sizeof(int);
+    }
+    return bytes;
+}
+
+struct SubsetHash {
+    size_t operator()(const vector<int>& s) const {
+        size_t h = s.size();
+        for (int q : s) {
+            h = (h ^ static_cast<size_t>(q)) * 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+// Feuille : un automate explicite et son index d'adjacence
+class BaseNode : public LazyNode {
+public:
+    explicit BaseNode(const Automaton& aut)
+        : aut(aut), adj(this->aut), final(aut.size(), false),
+          letters(aut.get_alphabet().begin(), aut.get_alphabet().end()) {
+        for (int q : aut.get_finals()) {
+            final[q] = true;
+        }
+        sortUnique(letters);
+    }
+
+    vector<int> initials() override {
+        vector<int> v(aut.get_inits().begin(), aut.get_inits().end());
+        sortUnique(v);
+        return v;
+    }
+
+    bool is_final(int s) override {
+        return final[s];
+    }
+
+    vector<int> successors(int s, char c) override {
+        vector<int> v;
+        auto range = adj.out(s, c);
+        for (const Adjacency::Edge* e = range.first; e != range.second; ++e) {
+            v.push_back(e->state);
+        }
+        return v;   // Déjà trié et sans doublon
+    }
+
+    vector<char> out_letters(int s) override {
+        vector<char> v;
+        for (const Adjacency::Edge* e = adj.out_begin(s); e != adj.out_end(s); ++e) {
+            if (v.empty() || v.back() != e->letter) {
+                v.push_back(e->letter);
+            }
+        }
+        return v;
+    }
+
+    const vector<char>& alphabet() const override {
+        return letters;
+    }
+
+    MemoryUsage memory_usage() const override {
+        MemoryUsage usage;
+        usage.add("aut", aut.memory_usage());
+        usage.add("adj", adj.memory_usage());
+        usage.add_vector("final", final);
+        usage.add_vector("letters", letters);
+        return usage;
+    }
+
+private:
+    Automaton aut;
+    Adjacency adj;
+    vector<bool> final;
+    vector<char> letters;
+};
+
+// Construction des sous-ensembles à la demande
+class DeterminizeNode : public LazyNode {
+public:
+    explicit DeterminizeNode(LazyAutomaton child) : child(child) {}
+
+    vector<int> initials() override {
+        return {intern(child->initials())};
+    }
+
+    bool is_final(int s) override {
+        for (int q : subsets[s]) {
+            if (child->is_final(q)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    vector<int> successors(int s, char c) override {
+        auto key = make_pair(s, c);
+        auto it = memo.find(key);
+        if (it == memo.end()) {
+            vector<int> next;
+            for (int q : subsets[s]) {
+                vector<int> succ = child->successors(q, c);
+                next.insert(next.end(), succ.begin(), succ.end());
+            }
+            sortUnique(next);
+            int id = next.empty() ? -1 : intern(next);
+            it = memo.emplace(key, id).first;
+        }
+        if (it->second < 0) {
+            return {};
+        }
+        return {it->second};
+    }
+
+    vector<char> out_letters(int s) override {
+        vector<char> v;
+        for (int q : subsets[s]) {
+            vector<char> l = child->out_letters(q);
+            v.insert(v.end(), l.begin(), l.end());
+        }
+        sortUnique(v);
+        return v;
+    }
+
+    const vector<char>& alphabet() const override {
+        return child->alphabet();
+    }
+
+    MemoryUsage memory_usage() const override {
+        MemoryUsage usage;
+        usage.add("subsets", subsetsBytes(subsets, false), subsetsBytes(subsets, true));
+        // Les clés de ids sont des copies des sous-ensembles
+        size_t keys = 0;
+        for (const auto& entry : ids) {
+            keys += entry.first.capacity() * sizeof(int);
+        }
+        usage.add_hash_map("ids", ids);
+        usage.add("ids.cles", keys, keys);
+        usage.add_hash_map("memo", memo);
+        usage.add("child", child->memory_usage());
+        return usage;
+    }
+
+private:
+    struct PairHash {
+        size_t operator()(const pair<int, char>& p) const {
+            return static_cast<size_t>(p.first) * 257 + static_cast<unsigned char>(p.second);
+        }
+    };
+
+    LazyAutomaton child;
+    vector<vector<int>> subsets;
+    unordered_map<vector<int>, int, SubsetHash> ids;
+    unordered_map<pair<int, char>, int, PairHash> memo;
+
+    int intern(const vector<int>& s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(subsets.size());
+        subsets.push_back(s);
+        ids.emplace(s, id);
+        return id;
+    }
+};
+
+// Complémentaire : déterminisation, complétion par un puits (état 0) et
+// échange des états finaux. L'état d du déterminisé devient d + 1.
+class ComplementNode : public LazyNode {
+public:
+    explicit ComplementNode(LazyAutomaton child)
+        : det(make_shared<DeterminizeNode>(child)) {}
+
+    vector<int> initials() override {
+        return {det->initials()[0] + 1};
+    }
+
+    bool is_final(int s) override {
+        return s == 0 || !det->is_final(s - 1);
+    }
+
+    vector<int> successors(int s, char c) override {
+        if (!binary_search(alphabet().begin(), alphabet().end(), c)) {
+            return {};
+        }
+        if (s == 0) {
+            return {0};
+        }
+        vector<int> next = det->successors(s - 1, c);
+        return {next.empty() ? 0 : next[0] + 1};
+    }
+
+    vector<char> out_letters(int) override {
+        return alphabet();
+    }
+
+    const vector<char>& alphabet() const override {
+        return det->alphabet();
+    }
+
+    MemoryUsage memory_usage() const override {
+        return det->memory_usage();
+    }
+
+private:
+    shared_ptr<DeterminizeNode> det;
+};
+
+// Produit synchrone : les paires d'états sont numérotées à la demande
+class IntersectionNode : public LazyNode {
+public:
+    IntersectionNode(LazyAutomaton a, LazyAutomaton b) : a(a), b(b) {
+        set_intersection(a->alphabet().begin(), a->alphabet().end(),
+                         b->alphabet().begin(), b->alphabet().end(), back_inserter(letters));
+    }
+
+    vector<int> initials() override {
+        vector<int> v;
+        for (int p : a->initials()) {
+            for (int q : b->initials()) {
+                v.push_back(intern(p, q));
+            }
+        }
+        sortUnique(v);
+        return v;
+    }
+
+    bool is_final(int s) override {
+        return a->is_final(pairs[s].first) && b->is_final(pairs[s].second);
+    }
+
+    vector<int> successors(int s, char c) override {
+        vector<int> v;
+        vector<int> next2 = b->successors(pairs[s].second, c);
+        if (next2.empty()) {
+            return v;
+        }
+        for (int p : a->successors(pairs[s].first, c)) {
+            for (int q : next2) {
+                v.push_back(intern(p, q));
+            }
+        }
+        sortUnique(v);
+        return v;
+    }
+
+    vector<char> out_letters(int s) override {
+        vector<char> la = a->out_letters(pairs[s].first);
+        vector<char> lb = b->out_letters(pairs[s].second);
+        vector<char> v;
+        set_intersection(la.begin(), la.end(), lb.begin(), lb.end(), back_inserter(v));
+        return v;
+    }
+
+    const vector<char>& alphabet() const override {
+        return letters;
+    }
+
+    MemoryUsage memory_usage() const override {
+        MemoryUsage usage;
+        usage.add_vector("pairs", pairs);
+        usage.add_hash_map("ids", ids);
+        usage.add("a", a->memory_usage());
+        usage.add("b", b->memory_usage());
+        return usage;
+    }
+
+private:
+    LazyAutomaton a;
+    LazyAutomaton b;
+    vector<char> letters;
+    vector<pair<int, int>> pairs;
+    unordered_map<uint64_t, int> ids;
+
+    int intern(int p, int q) {
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(p)) << 32) | static_cast<uint32_t>(q);
+        auto it = ids.find(key);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(pairs.size());
+        pairs.emplace_back(p, q);
+        ids.emplace(key, id);
+        return id;
+    }
+};
+
+// Union disjointe : l'état p de a devient 2p, l'état q de b devient 2q + 1
+class UnionNode : public LazyNode {
+public:
+    UnionNode(LazyAutomaton a, LazyAutomaton b) : sides{a, b} {
+        set_union(a->alphabet().begin(), a->alphabet().end(),
+                  b->alphabet().begin(), b->alphabet().end(), back_inserter(letters));
+    }
+
+    vector<int> initials() override {
+        vector<int> v;
+        for (int side = 0; side < 2; ++side) {
+            for (int q : sides[side]->initials()) {
+                v.push_back(2 * q + side);
+            }
+        }
+        sortUnique(v);
+        return v;
+    }
+
+    bool is_final(int s) override {
+        return sides[s % 2]->is_final(s / 2);
+    }
+
+    vector<int> successors(int s, char c) override {
+        vector<int> v = sides[s % 2]->successors(s / 2, c);
+        for (int& q : v) {
+            q = 2 * q + s % 2;
+        }
+        return v;
+    }
+
+    vector<char> out_letters(int s) override {
+        return sides[s % 2]->out_letters(s / 2);
+    }
+
+    const vector<char>& alphabet() const override {
+        return letters;
+    }
+
+    MemoryUsage memory_usage() const override {
+        MemoryUsage usage;
+        usage.add("a", sides[0]->memory_usage());
+        usage.add("b", sides[1]->memory_usage());
+        return usage;
+    }
+
+private:
+    LazyAutomaton sides[2];
+    vector<char> letters;
+};
+
+// Émondage : transparent pour les requêtes, appliqué par materialize()
+class TrimNode : public LazyNode {
+public:
+    explicit TrimNode(LazyAutomaton child) : child(child) {}
+
+    vector<int> initials() override {
+        return child->initials();
+    }
+
+    bool is_final(int s) override {
+        return child->is_final(s);
+    }
+
+    vector<int> successors(int s, char c) override {
+        return child->successors(s, c);
+    }
+
+    vector<char> out_letters(int s) override {
+        return child->out_letters(s);
+    }
+
+    const vector<char>& alphabet() const override {
+        return child->alphabet();
+    }
+
+    bool trimmed() const override {
+        return true;
+    }
+
+    MemoryUsage memory_usage() const override {
+        return child->memory_usage();
+    }
+
+private:
+    LazyAutomaton child;
+};
+
+// Parcours en largeur depuis les états initiaux de a. visit(s) est appelé
+// sur chaque état découvert ; s'il retourne true, le parcours s'arrête et
+// parent reçoit, pour chaque état découvert, l'état et la lettre par
+// lesquels il l'a été.
+template <typename Visit>
+int explore(LazyNode& a, unordered_map<int, pair<int, char>>& parent, Visit visit) {
+    vector<int> queue;
+    for (int s : a.initials()) {
+        if (parent.emplace(s, make_pair(-1, '\0')).second) {
+            queue.push_back(s);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int s = queue[head];
+        if (visit(s)) {
+            return s;
+        }
+        for (char c : a.out_letters(s)) {
+            for (int t : a.successors(s, c)) {
+                if (parent.emplace(t, make_pair(s, c)).second) {
+                    queue.push_back(t);
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+LazyAutomaton lazy(const Automaton& aut) {
+    return make_shared<BaseNode>(aut);
+}
+
+LazyAutomaton lazyDeterminize(LazyAutomaton a) {
+    return make_shared<DeterminizeNode>(a);
+}
+
+LazyAutomaton lazyComplement(LazyAutomaton a) {
+    return make_shared<ComplementNode>(a);
+}
+
+LazyAutomaton lazyIntersection(LazyAutomaton a, LazyAutomaton b) {
+    return make_shared<IntersectionNode>(a, b);
+}
+
+LazyAutomaton lazyUnion(LazyAutomaton a, LazyAutomaton b) {
+    return make_shared<UnionNode>(a, b);
+}
+
+LazyAutomaton lazyTrim(LazyAutomaton a) {
+    return make_shared<TrimNode>(a);
+}
+
+bool appartient(LazyAutomaton a, const string& word) {
+    vector<int> current = a->initials();
+    for (char c : word) {
+        vector<int> next;
+        for (int s : current) {
+            vector<int> succ = a->successors(s, c);
+            next.insert(next.end(), succ.begin(), succ.end());
+        }
+        if (next.empty()) {
+            return false;
+        }
+        sortUnique(next);
+        current.swap(next);
+    }
+    for (int s : current) {
+        if (a->is_final(s)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool emptyLanguage(LazyAutomaton a) {
+    unordered_map<int, pair<int, char>> parent;
+    return explore(*a, parent, [&a](int s) { return a->is_final(s); }) < 0;
+}
+
+bool shortestWord(LazyAutomaton a, string& word) {
+    unordered_map<int, pair<int, char>> parent;
+    int s = explore(*a, parent, [&a](int s) { return a->is_final(s); });
+    if (s < 0) {
+        return false;
+    }
+    string w;
+    for (; parent[s].first >= 0; s = parent[s].first) {
+        w.push_back(parent[s].second);
+    }
+    reverse(w.begin(), w.end());
+    word = w;
+    return true;
+}
+
+Automaton materialize(LazyAutomaton a) {
+    unordered_map<int, pair<int, char>> parent;
+    unordered_map<int, int> number;     // état du noeud -> état du résultat
+    vector<int> order;
+    explore(*a, parent, [&](int s) {
+        number.emplace(s, static_cast<int>(order.size()));
+        order.push_back(s);
+        return false;
+    });
+
+    Automaton result;
+    for (size_t i = 0; i < order.size(); ++i) {
+        result.newstate();
+    }
+    for (int s : a->initials()) {
+        result.add_init(number[s]);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        int s = order[i];
+        if (a->is_final(s)) {
+            result.add_final_unchecked(static_cast<int>(i));
+        }
+        for (char c : a->out_letters(s)) {
+            for (int t : a->successors(s, c)) {
+                result.add_trans_unchecked(static_cast<int>(i), c, number[t]);
+            }
+        }
+    }
+    return a->trimmed() ? trim(result) : result;
+}
@@ -1,394 +1,60 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "automaton.h"
+#include "automatongraphview.h"
+#include "constdfa.h"
 #include "idxset.h"
+#include "incremental.h"
+#include "lazy.h"
+#include "memusage.h"
+#include "opcache.h"
+#include "operations.h"
+#include "parallelgraph.h"
+#include "rangeautomaton.h"
+#include "equivalence.h"
+#include "graphmodel.h"
+#include "hybriddfa.h"
+#include "regex.h"
+#include "search.h"
+#include "shiftand.h"
+#include "words.h"
+#include <QFileDialog>
+#include <QStatusBar>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <tuple>
 #include <sstream>
 
 using namespace std;
-//===================== A faire 1 ===========================
-/**
- * @brief vectMeme Vérifie si un entier est présent dans un vecteur.
- *
- * @param vect Le vecteur d'entiers à parcourir.
- * @param n L'entier à rechercher dans le vecteur.
- * @return true Si l'entier est présent dans le vecteur.
- * @return false Sinon.
- */
-bool vectMeme(const vector<int> &vect, int n){
-    for (auto v: vect){
-        if (v== n) return true;
-    }
-    return false;
-}
-//==========================================================
-
-
-//===================== A faire 2 ===========================
-/**
- * @brief vectIntersection Fait l'intersection entre deux vecteurs.
- *
- * @param vect1 le premier vecteur.
- * @param vect2 le deuxième vecteur.
- * @return le vecteur résultant
- */
-vector <int> vectIntersection(const vector<int> &vect1, const vector<int> &vect2){
-    vector <int> result;
-    for (auto v: vect1){
-        if (vectMeme(vect2,v))result.push_back(v);
-    }
-    return result;
-}
-//===========================================================
-
-
-//===================== A faire 3 ===========================
-/**
- * @brief succesors retourne l'ensemble des états de l'automate
- * qui sont des successeurs de l'un des états de srcs à travers c
- * @param aut l'automate
- * @param srcs les états sources
- * @param c l'etiquette de la transition
- * @return un ensemble d'état successeurs.
- */
-IdxSet <int> succesors (const Automaton &aut, const IdxSet<int> &srcs, char c){
-    IdxSet <int> result;
-    for (int q : srcs){ // parcours des états initiaux
-        for (int des : aut.out_states(q,c))result.add(des);
-    }
-    return result;
-}
-//===========================================================
-
-
-//===================== A faire 4 ===========================
-/**
- * @brief succesors retourne l'ensemble des états de l'automate
- * qui sont des successeurs de l'un des états de srcs étiquettée par le mot word
- * @param aut l'automate
- * @param srcs les états sources
- * @param word le mot
- * @return un ensemble d'état successeurs
- */
-IdxSet <int> succesors (const Automaton &aut, const IdxSet<int> &srcs, const string &word){
-    IdxSet <int> current = srcs; // on commence par les états initiaux
-    for (char c : word) current = succesors(aut, current, c); // update après chaque lettre
-    return current; // états atteints après avoir lu le mot.
-}
-//===========================================================
-
-
-//===================== A faire 5 ===========================
-/**
- * @brief appartient indique si un mot est reconnue par l'automate
- * @param aut l'automate
- * @param word mot à tester
- * @return true si le mot est reconnu
- * @return false si le mot n'est pas reconnu
- */
-bool appartient(const Automaton &aut, const string &word){
-    IdxSet <int> reachables = succesors(aut, aut.get_inits(), word);
-    for (auto q : reachables){
-        if (aut.is_final(q))return true;
-    }
-    return false;
-}
-//===========================================================
-
-
-//===================== A faire 6 ===========================
-/**
- * @brief succesorsStar trouve l'ensemble des états accessibles par les états contenus dsans srscs
- * @param aut l'automate
- * @param srcs  etats sources
- * @return ensemble des états accessibles
- */
-IdxSet<int> succesorsStar(const Automaton &aut, const IdxSet<int> &srcs){
-    IdxSet<int> reachables = srcs;// état de départ
-    IdxSet<int> toBeTreated = srcs;// état à traiter
-    while(!toBeTreated.is_empty()){
-        int q = toBeTreated.choose();
-        for (auto c: aut.out_letters(q)){// Les lettres sortantes
-            for (auto qPrime : aut.out_states(q,c)){// Les états de destinations
-                if (!reachables.mem(qPrime)){
-                    reachables.add(qPrime);
-                    toBeTreated.add(qPrime);
-                }
-            }
-        }
-    }
-    return reachables;
-}
-//===========================================================
-
-
-//===================== A faire 7 ===========================
-/**
- * @brief emptyLanguage indique si le language reconnu par l'automate est vide
- * @param aut l'automate
- * @return  true si le language est vide
- * @return false si le language n'est pas vide
- */
-bool emptyLanguage(Automaton aut){
-    // Calculer tous les états accessibles à partir des états initiaux
-    IdxSet<int> reachables = succesorsStar(aut, aut.get_inits());
-
-    // Vérifier si au moins un état accessible est final
-    for (int q : reachables) {
-        if (aut.is_final(q)) {
-            return false; // Le langage n'est pas vide
-        }
-    }
-
-    return true; // Le langage est vide
-}
-//===========================================================
-
-
-//===================== A faire 9 ===========================
-/**
- * @brief predecessorsStar trouve l'ensemble des états co-accessibles contenus dans srcs
- * @param aut l'automate
- * @param srcs état source
- * @return
- */
-IdxSet<int> predecessorsStar(const Automaton &aut, const IdxSet<int> &srcs) {
-    IdxSet<int> reachables = srcs;// état de départ
-    IdxSet<int> toBeTreated = srcs;// état à traiter
-
-    while (!toBeTreated.is_empty()) {
-        int q = toBeTreated.choose();
-
-        for (char a : aut.in_letters(q)) {// lettre Entrante
-            for (int q_prime : aut.in_states(a, q)) {// Etat de provenance
-                if (!reachables.mem(q_prime)) {
-                    reachables.add(q_prime);
-                    toBeTreated.add(q_prime);
-                }
-            }
-        }
-    }
-    return reachables;
-}
-/**
- * @brief trim trouve un automate dont tous les états sont accessibles et co-accessibles
- * @brief suppression des états inutiles
- * @param aut l'automate
- * @return un automate
- */
-Automaton trim(const Automaton &aut) {
-    IdxSet<int> accessible = succesorsStar(aut, aut.get_inits());
-    IdxSet<int> coaccessible = predecessorsStar(aut, aut.get_finals());
-
-    Automaton result;
-
-    // Ajout des états utiles (intersection des accessibles et co-accessibles)
-    // On conserve les identifiants d'origine pour simplifier la copie des
-    // transitions.
-    for (int s : accessible) {
-        if (coaccessible.mem(s)) {
-            if (aut.get_inits().mem(s))
-                result.add_init(s);
-            if (aut.get_finals().mem(s))
-                result.add_final(s);
-        }
-    }
-
-    // Ajout des transitions entre états utiles
-    for (const auto &t : aut.get_trans()) {
-        int src = get<0>(t);// état source de t
-        int dst = get<2>(t);// état de destination de t
-        char c = get<1>(t);// caractère étiquettant t
-
-        // Une transition est conservée si ses deux extrémités sont utiles
-        if (accessible.mem(src) && coaccessible.mem(src) && accessible.mem(dst) &&
-            coaccessible.mem(dst)) {
-            result.add_trans(src, c, dst);
-        }
-    }
-
-    return result;
-}
-
-//===========================================================
-
-
-//===================== A faire 10 ==========================
-/**
- * @brief intersection donne l'automate d'intersection de deux automates
- * @param aut1 premier automate
- * @param aut2 deuxième automate
- * @return l'automate résultant
- */
-Automaton intersection(const Automaton &aut1, const Automaton &aut2) {
-    Automaton result;
-    IdxSet<pair<int, int>>
-        pairs; // Mappe les paires d'états vers un nouvel index unique
-    IdxSet<int> to_be_treated; // Liste de travail des index d'états à traiter
-    IdxSet<int> treated;       // Ensemble des index d'états déjà traités
-
-    // Initialisation avec les paires d'états initiaux
-    for (int init1 : aut1.get_inits()) {
-        for (int init2 : aut2.get_inits()) {
-            int p = pairs.addindex(make_pair(init1, init2));
-            result.add_init(p);
-            to_be_treated.add(p);
-        }
-    }
-
-    while (!to_be_treated.is_empty()) {
-        int p_idx = to_be_treated.choose();
-        if (treated.mem(p_idx))
-            continue;
-        treated.add(p_idx);
-
-        pair<int, int> p_pair = pairs.at(p_idx);
-        int p1 = p_pair.first;
-        int p2 = p_pair.second;
-
-        // Un état produit est final si les deux états composants sont finaux
-        if (aut1.is_final(p1) && aut2.is_final(p2)) {
-            result.add_final(p_idx);
-        }
-
-        // Calcul des transitions possibles
-        IdxSet<char> alpha1 = aut1.out_letters(p1);
-        IdxSet<char> alpha2 = aut2.out_letters(p2);
-
-        for (char c : alpha1) {
-            if (alpha2.mem(c)) { // Si la lettre est commune
-                IdxSet<int> next1 = aut1.out_states(p1, c);
-                IdxSet<int> next2 = aut2.out_states(p2, c);
-
-                for (int n1 : next1) {
-                    for (int n2 : next2) {
-                        int next_idx = pairs.addindex(make_pair(n1, n2));
-                        result.add_trans(p_idx, c, next_idx);
-
-                        // Si le nouvel état n'a pas encore été traité, on l'ajoute à la
-                        // liste
-                        if (!treated.mem(next_idx) && !to_be_treated.mem(next_idx)) {
-                            to_be_treated.add(next_idx);
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return result;
-}
-
-//===========================================================
-
-//==================== A faire 11 ===========================
-/**
- * Déterminise un automate non déterministe (NFA) en utilisant l'algorithme des
- * sous-ensembles (subset construction). Chaque état du nouvel automate
- * correspond à un ensemble d'états de l'automate d'origine.
- * @param aut L'automate à déterminiser.
- * @return Un automate déterministe équivalent.
- */
-Automaton determinize(const Automaton &aut) {
-    Automaton det;
-    IdxSet<IdxSet<int>>
-        statesets; // Mappe un ensemble d'états vers un nouvel index unique
-    IdxSet<int> to_be_treated;
-    IdxSet<int> treated;
-
-    // L'état initial du DFA est l'ensemble des états initiaux du NFA
-    IdxSet<int> inits = aut.get_inits();
-    int init_idx = statesets.addindex(inits);
-    det.add_init(init_idx);
-    to_be_treated.add(init_idx);
-
-    while (!to_be_treated.is_empty()) {
-        int curr_idx = to_be_treated.choose();
-        if (treated.mem(curr_idx))
-            continue;
-        treated.add(curr_idx);
-
-        IdxSet<int> curr_set = statesets.at(curr_idx);// ensemble
-
-        // Un état du DFA est final s'il contient au moins un état final du NFA
-        for (int s : curr_set) {
-            if (aut.is_final(s)) {
-                det.add_final(curr_idx);
-                break;
-            }
-        }
-
-        // Pour chaque lettre de l'alphabet
-        for (char c : aut.get_alphabet()) {
-            IdxSet<int> next_set; // ensemble des états atteints depuis tous les états de curr_set
-            // On calcule l'union des transitions pour tous les états du sous-ensemble
-            // courant
-            for (int s : curr_set) {
-                next_set.add(aut.out_states(s, c));
-            }
-
-            if (!next_set.is_empty()) {
-                int next_idx = statesets.addindex(next_set);
-                det.add_trans(curr_idx, c, next_idx);
-
-                if (!treated.mem(next_idx) && !to_be_treated.mem(next_idx)) {
-                    to_be_treated.add(next_idx);
-                }
-            }
-        }
-    }
 
-    return det;
-}
+// Version construite à la compilation de l'automate aut1 de testAutomaton
+static constexpr auto aut1Const = constDeterminize<16, 4>(
+    {1},
+    {{1, 'a', 2}, {2, 'b', 3}, {3, 'c', 4},
+     {1, 'a', 1}, {1, 'b', 1}, {1, 'c', 1},
+     {4, 'a', 4}, {4, 'b', 4}, {4, 'c', 4}},
+    {4});
+static_assert(ConstMatcher<aut1Const>::appartient("abbabca"));
+static_assert(ConstMatcher<aut1Const>::appartient("aaaabcbb"));
+static_assert(!ConstMatcher<aut1Const>::appartient("aaaabbb"));
 
-//==========================================================
-
-//========================== A faire 12 =====================
-Automaton complement(const Automaton &aut){
-    // 1. determinisation
-    Automaton deter = determinize(aut);
-
-    // 2. Complétion de l'automate : ajout du puit pour les transitions manquantes
-    int puit = deter.size(); // Nouvel état puit
-    bool puit_needed = false;
-    for (int q = 0; q < deter.size(); ++q) {
-        for (char c : deter.get_alphabet()) {
-            if (deter.out_states(q, c).is_empty()) {
-                deter.add_trans(q, c, puit);
-                puit_needed = true;
-            }
-        }
-    }
-    // Ajout de la boucle sur le puit
-    if (puit_needed) {
-        for (char c : deter.get_alphabet()) {
-            deter.add_trans(puit, c, puit); // Le puits boucle sur lui-même
-        }
-    }
-    // 3. Inversion des étas finaux
-    Automaton complement;
-    int total_etat = deter.size() + (puit_needed ? 1 : 0);
-    for (int q = 0; q < total_etat; q++){
-        if (deter.get_inits().mem(q))complement.add_init(q);// les états initiaux restent initiaux
-        if (!deter.is_final(q))complement.add_final(q);// les états non finaux deviennent finaux
-    }
-    // On copie toutes les transistions
-    complement.add_trans(deter.get_trans());
-
-    return complement;
-}
-//============================================================
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , operations(64)
 {
     ui->setupUi(this);
 
     // Connecter les boutons aux slots
     connect(ui->testAutomatonButton, &QPushButton::clicked,
             this, &MainWindow::on_testAutomatonButton_clicked);
+    connect(ui->exportDotButton, &QPushButton::clicked,
+            this, &MainWindow::exportDot);
+    // showMessage a un second paramètre (durée) : une connexion directe
+    // au pointeur de membre serait refusée par Qt
+    connect(ui->graphView, &AutomatonGraphView::statusMessage,
+            this, [this](const QString& message) { statusBar()->showMessage(message); });
 
 }
 
@@ -402,6 +68,20 @@ void MainWindow::on_testAutomatonButton_clicked()
     testAutomaton();
 }
 
+void MainWindow::exportDot()
+{
+    QString fichier = QFileDialog::getSaveFileName(this, "Exporter en DOT", "automate.dot",
+                                                   "Graphviz (*.dot)");
+    if (fichier.isEmpty()) {
+        return;
+    }
+    ofstream os(fichier.toStdString());
+    writeDot(shownAutomaton, os);
+    os.close();
+    statusBar()->showMessage(os ? "Automate exporte dans " + fichier
+                                : "Echec de l'ecriture de " + fichier);
+}
+
 void MainWindow::testAutomaton()
 {
     ui->textOutput->clear();
@@ -448,28 +128,205 @@ void MainWindow::testAutomaton()
                  : "le language n'est pas vide ")
          << endl;
     cout<< "\t\tTest 4: Fonction Trim"<< endl;cout<< endl;
-    Automaton aut_trim = trim(aut1);
+    vector<int> old2new;
+    Automaton aut_trim = trim(aut1, old2new);
     aut_trim.print();
+    cout<< "Renumerotation :";
+    for (int q = 0; q < aut1.size(); ++q) {
+        cout<< " " << q << "->" << old2new[q];
+    }
+    cout<< endl;
 
     cout<< "\t\tTest 5: Fonction Intersection d'automate"<< endl;cout<< endl;
     Automaton aut_empty({1}, { {1,'d',1}, {1,'e',1} },{1});
     Automaton aut_non_empty({1}, { {1,'a',2}, {2,'b',3}, {3,'c',4} },{4});
 
-    Automaton intersect = intersection(aut1, aut_empty);
+    // Empreinte de aut1 calculée une fois pour les tests 5 à 7
+    AutomatonHash hash1 = structuralHash(aut1);
+    shared_ptr<const Automaton> intersect =
+        operations.intersection(aut1, hash1, aut_empty, structuralHash(aut_empty));
     cout<< "L'intersection d'automate"<<endl;
-    intersect.print();
+    intersect->print();
 
-    Automaton intersect1 = intersection(aut1, aut_non_empty);
-    intersect1.print();
+    shared_ptr<const Automaton> intersect1 =
+        operations.intersection(aut1, hash1, aut_non_empty, structuralHash(aut_non_empty));
+    intersect1->print();
 
     cout<< "\t\tTest 6: Determinisation"<< endl;cout<< endl;
-    Automaton determiniser = determinize(aut1);
-    determiniser.print();
+    shared_ptr<const Automaton> determiniser = operations.determinize(aut1, hash1);
+    determiniser->print();
 
     cout<< "\t\tTest 7: Complementaire de l'automate"<< endl;cout<< endl;
-    Automaton complementaire = complement(aut1);
-    complementaire.print();
+    shared_ptr<const Automaton> complementaire = operations.complement(aut1, hash1);
+    complementaire->print();
+    cout<< "Cache des operations : " << operations.size() << " resultats, "
+         << operations.hits() << " trouves, " << operations.misses() << " calcules" << endl;
+
+    cout<< "\t\tTest 8: Expression reguliere (Glushkov)"<< endl;cout<< endl;
+    Automaton aut_regex = glushkov("[a-c]*abc[a-c]*");
+    aut_regex.print();
+    cout<< (appartient(aut_regex,"aaaabcbb")
+                 ? "aaaabcbb appartient à l'automate"
+                 : "aaaabcbb n'appartient pas à l'automate ")
+         << endl;
+
+    cout<< "\t\tTest 9: Appartenance bit-parallele (Shift-And)"<< endl;cout<< endl;
+    Matcher matcher(aut1);
+    cout<< "Moteur sur " << matcher.width() << " bits" << endl;
+    for (const string& w : {"abbabca", "aaaabcbb", "aaaabbb"}) {
+        cout<< w << (matcher.appartient(w) == appartient(aut1, w)
+                         ? " : meme resultat que appartient"
+                         : " : RESULTAT DIFFERENT de appartient")
+             << endl;
+    }
+
+    cout<< "\t\tTest 10: Equivalence de langages"<< endl;cout<< endl;
+    string distinguant;
+    cout<< (equivalent(aut1, *determiniser)
+                 ? "aut1 et son determinise sont equivalents"
+                 : "aut1 et son determinise ne sont pas equivalents")
+         << endl;
+    if (!equivalent(aut1, aut_regex, &distinguant)) {
+        cout<< "aut1 et [a-c]*abc[a-c]* different sur le mot \"" << distinguant << "\"" << endl;
+    }
+
+    cout<< "\t\tTest 11: Mots reconnus"<< endl;cout<< endl;
+    string temoin;
+    if (shortestWord(aut1, temoin)) {
+        cout<< "Plus court mot reconnu : " << temoin << endl;
+    }
+    cout<< "Mots reconnus de longueur au plus 4 :";
+    enumerateWords(aut1, 4, [](const string& w) {
+        cout<< " " << w;
+        return true;
+    });
+    cout<< endl;
+    vector<uint64_t> nombres = countWords(aut1, 6);
+    for (size_t l = 0; l < nombres.size(); ++l) {
+        cout<< "Longueur " << l << " : " << nombres[l] << " mots" << endl;
+    }
+
+    cout<< "\t\tTest 12: Automate construit a la compilation"<< endl;cout<< endl;
+    cout<< ConstMatcher<aut1Const>::size() << " etats calcules a la compilation" << endl;
+    for (const string& w : {"abbabca", "aaaabcbb", "aaaabbb"}) {
+        cout<< w << (ConstMatcher<aut1Const>::appartient(w) == appartient(aut1, w)
+                         ? " : meme resultat que appartient"
+                         : " : RESULTAT DIFFERENT de appartient")
+             << endl;
+    }
+
+    cout<< "\t\tTest 13: Expression evaluee a la demande"<< endl;cout<< endl;
+    LazyAutomaton expression = lazyIntersection(lazyComplement(lazy(aut1)), lazyTrim(lazy(aut_regex)));
+    string difference;
+    if (shortestWord(expression, difference)) {
+        cout<< "Plus court mot de [a-c]*abc[a-c]* non reconnu par aut1 : " << difference << endl;
+    } else {
+        cout<< "[a-c]*abc[a-c]* est inclus dans le langage de aut1" << endl;
+    }
+    Automaton materialise = materialize(expression);
+    cout<< "Automate construit : " << materialise.size() << " etats" << endl;
+
+    cout<< "\t\tTest 14: Transitions etiquetees par des intervalles"<< endl;cout<< endl;
+    Automaton aut_imprimable = glushkov(".*@[a-z]+");
+    RangeAutomaton aut_intervalles(aut_imprimable);
+    cout<< ".*@[a-z]+ : " << aut_imprimable.get_trans().size() << " transitions par lettre, "
+         << aut_intervalles.nb_transitions() << " par intervalle" << endl;
+    RangeAutomaton aut_grec;
+    int grec0 = aut_grec.newstate();
+    int grec1 = aut_grec.newstate();
+    aut_grec.add_init(grec0);
+    aut_grec.add_final(grec1);
+    aut_grec.add_trans(grec0, U'\u03B1', U'\u03C9', grec1);
+    aut_grec.add_trans(grec1, U'\u03B1', U'\u03C9', grec1);
+    complement(aut_grec).print();
+    for (const string& w : {"\u03B1\u03B2\u03B3", "abc"}) {
+        cout<< w << (aut_grec.appartientUtf8(w) ? " est" : " n'est pas")
+             << " un mot de lettres grecques minuscules" << endl;
+    }
+
+    cout<< "\t\tTest 15: Occupation memoire"<< endl;cout<< endl;
+    cout<< "aut1 :" << endl << aut1.memory_usage().report();
+    cout<< "Moteur Shift-And de aut1 :" << endl << matcher.memory_usage().report();
+    cout<< "Expression du test 13 :" << endl << expression->memory_usage().report();
+    cout<< "Cache des operations :" << endl << operations.memory_usage().report();
+    {
+        PeakMemoryScope pic;
+        Automaton determinise = determinize(aut_regex);
+        cout<< "Determinise de [a-c]*abc[a-c]* :" << endl << determinise.memory_usage().report();
+        if (PeakMemoryScope::enabled()) {
+            cout<< "Pic d'allocation pendant determinize : " << formatBytes(pic.peak()) << endl;
+        }
+    }
+
+    cout<< "\t\tTest 16: Recherche dans un texte"<< endl;cout<< endl;
+    string texte = "ccabcaab abcbbabcc";
+    for (MatchSemantics semantique : {MatchSemantics::LeftmostLongest, MatchSemantics::LeftmostFirst}) {
+        Searcher recherche(glushkov("ab(c|b)*"), semantique);
+        cout<< (semantique == MatchSemantics::LeftmostLongest ? "Plus longues" : "Premieres")
+             << " occurrences (prefiltre " << recherche.prefilter() << ") :";
+        for (const Match& m : recherche.findAll(texte)) {
+            cout<< " [" << m.start << "," << m.end << "[ " << texte.substr(m.start, m.end - m.start);
+        }
+        cout<< endl;
+    }
+
+    cout<< "\t\tTest 17: Determinisation incrementale"<< endl;cout<< endl;
+    IncrementalDeterminizer incremental(aut1);
+    cout<< incremental.dfa().size() << " etats pour aut1" << endl;
+    int nouvel_etat = incremental.newstate();
+    incremental.add_trans(1, 'd', nouvel_etat);
+    incremental.add_final(nouvel_etat);
+    cout<< "Apres ajout de 1 -d-> " << nouvel_etat << " (final) : "
+         << incremental.dfa().size() << " etats, "
+         << (equivalent(incremental.dfa(), determinize(incremental.nfa()))
+                 ? "equivalent a determinize"
+                 : "DIFFERENT de determinize")
+         << ", " << incremental.nb_subsets() << " sous-ensembles gardes" << endl;
+
+    cout<< "\t\tTest 18: Vue graphique d'un grand automate"<< endl;cout<< endl;
+    // Chaine de 200000 etats avec raccourcis et quelques retours en arriere
+    // (composantes de 51 etats, repliees) : la vue n'en affiche qu'un
+    // voisinage, double clic pour explorer
+    Automaton grand;
+    const int nb_etats = 200000;
+    for (int q = 0; q < nb_etats; ++q) {
+        grand.newstate();
+    }
+    grand.add_init(0);
+    for (int q = 0; q < nb_etats; ++q) {
+        if (q + 1 < nb_etats) {
+            grand.add_trans_unchecked(q, 'a', q + 1);
+        }
+        if (2 * q + 1 < nb_etats) {
+            grand.add_trans_unchecked(q, 'b', 2 * q + 1);
+        }
+        if (q % 1000 == 999) {
+            grand.add_trans_unchecked(q, 'c', q - 50);
+            grand.add_final_unchecked(q);
+        }
+    }
+    cout<< grand.size() << " etats, " << grand.get_trans().size() << " transitions" << endl;
+    shownAutomaton = grand;
+    ui->graphView->setAutomaton(shownAutomaton);
+
+    cout<< "\t\tTest 19: Disposition adaptee a chaque etat"<< endl;cout<< endl;
+    shared_ptr<const Automaton> deterministe = operations.determinize(aut_regex);
+    HybridDfa hybride(*deterministe);
+    HybridDfa compact(*deterministe, 0);
+    cout<< "Budget de lignes denses par defaut : " << hybride.report()
+         << "Sans lignes denses : " << compact.report();
+    for (const string& w : {"abbabca", "aaaabcbb", "aaaabbb"}) {
+        cout<< w << " : " << (compact.appartient(w) ? "accepte" : "refuse") << endl;
+    }
 
+    cout<< "\t\tTest 20: Composantes fortement connexes en parallele"<< endl;cout<< endl;
+    SccDecomposition composantes = parallelScc(Adjacency(aut1));
+    cout<< "aut1 : " << composantes.count() << " composantes fortement connexes" << endl;
+    cout<< "aut1 : langage " << (infiniteLanguage(aut1) ? "infini" : "fini") << endl;
+    cout<< "[a-c]*abc[a-c]* : langage " << (infiniteLanguage(aut_regex) ? "infini" : "fini")
+        << (parallelEmptyLanguage(aut_regex) ? ", vide" : ", non vide") << endl;
+    cout<< "Grand automate du test 18 : " << parallelScc(Adjacency(shownAutomaton)).count()
+        << " composantes fortement connexes" << endl;
 
     cout.rdbuf(old);
     ui->textOutput->appendPlainText(QString::fromStdString(buffer.str()));
@@ -0,0 +1,169 @@
+#include "memusage.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+using namespace std;
+
+void MemoryUsage::add(const string& name, size_t used, size_t reserved) {
+    parts.push_back({name, used, reserved});
+}
+
+void MemoryUsage::add(const string& prefix, const MemoryUsage& other) {
+    for (const Component& c : other.parts) {
+        parts.push_back({prefix + "." + c.name, c.used, c.reserved});
+    }
+}
+
+const vector<MemoryUsage::Component>& MemoryUsage::components() const {
+    return parts;
+}
+
+size_t MemoryUsage::used() const {
+    size_t total = 0;
+    for (const Component& c : parts) {
+        total += c.used;
+    }
+    return total;
+}
+
+size_t MemoryUsage::reserved() const {
+    size_t total = 0;
+    for (const Component& c : parts) {
+        total += c.reserved;
+    }
+    return total;
+}
+
+string formatBytes(size_t bytes) {
+    const char* units[] = {"o", "Kio", "Mio", "Gio", "Tio"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024 && unit < 4) {
+        value /= 1024;
+        ++unit;
+    }
+    char buf[32];
+    if (unit == 0) {
+        snprintf(buf, sizeof(buf), "%zu o", bytes);
+    } else {
+        snprintf(buf, sizeof(buf), "%.1f %s", value, units[unit]);
+    }
+    return buf;
+}
+
+string MemoryUsage::report() const {
+    size_t width = 5;
+    for (const Component& c : parts) {
+        width = max(width, c.name.size());
+    }
+    ostringstream os;
+    char line[256];
+    auto row = [&](const string& name, const string& used, const string& reserved) {
+        snprintf(line, sizeof(line), "%-*s  %12s  %12s\n",
+                 static_cast<int>(width), name.c_str(), used.c_str(), reserved.c_str());
+        os << line;
+    };
+    row("", "utilise", "reserve");
+    for (const Component& c : parts) {
+        row(c.name, formatBytes(c.used), formatBytes(c.reserved));
+    }
+    row("Total", formatBytes(used()), formatBytes(reserved()));
+    return os.str();
+}
+
+#ifdef AUTOMATON_TRACK_ALLOCATIONS
+
+namespace {
+
+atomic<size_t> current{0};
+atomic<size_t> highest{0};
+
+// La taille demandée est rangée juste avant le bloc rendu à l'appelant
+constexpr size_t header = alignof(max_align_t);
+
+void* allocate(size_t n) {
+    void* base = malloc(n + header);
+    if (base == nullptr) {
+        throw bad_alloc();
+    }
+    *static_cast<size_t*>(base) = n;
+    size_t now = current.fetch_add(n) + n;
+    size_t peak = highest.load();
+    while (now > peak && !highest.compare_exchange_weak(peak, now)) {
+    }
+    return static_cast<char*>(base) + header;
+}
+
+void release(void* p) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    char* base = static_cast<char*>(p) - header;
+    current.fetch_sub(*reinterpret_cast<size_t*>(base));
+    free(base);
+}
+
+} // namespace
+
+void* operator new(size_t n) {
+    return allocate(n);
+}
+
+void* operator new[](size_t n) {
+    return allocate(n);
+}
+
+void operator delete(void* p) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    release(p);
+}
+
+PeakMemoryScope::PeakMemoryScope() : start(current.load()) {
+    highest.store(start);
+}
+
+size_t PeakMemoryScope::peak() const {
+    size_t h = highest.load();
+    return h > start ? h - start : 0;
+}
+
+size_t PeakMemoryScope::allocated() {
+    return current.load();
+}
+
+bool PeakMemoryScope::enabled() {
+    return true;
+}
+
+#else
+
+PeakMemoryScope::PeakMemoryScope() : start(0) {}
+
+size_t PeakMemoryScope::peak() const {
+    return 0;
+}
+
+size_t PeakMemoryScope::allocated() {
+    return 0;
+}
+
+bool PeakMemoryScope::enabled() {
+    return false;
+}
+
+#endif // AUTOMATON_TRACK_ALLOCATIONS
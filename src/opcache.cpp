@@ -0,0 +1,320 @@
+#include "opcache.h"
+#include "operations.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <tuple>
+
+using namespace std;
+
+namespace {
+
+// Fonction de mélange de splitmix64
+uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Accumule les valeurs dans deux empreintes indépendantes
+struct Hasher {
+    uint64_t h1 = 0x6a09e667f3bcc908ULL;
+    uint64_t h2 = 0xbb67ae8584caa73bULL;
+
+    void feed(uint64_t v) {
+        h1 = mix(h1 ^ v);
+        h2 = mix(h2 + v * 0x9fb21c651e98df25ULL);
+    }
+
+    // Les ensembles sont triés avant d'être accumulés, et précédés de
+    // leur taille pour séparer les sections.
+    template <typename T>
+    void feedSet(vector<T> v) {
+        sort(v.begin(), v.end());
+        feed(v.size());
+        for (const T& x : v) {
+            feed(static_cast<uint64_t>(x));
+        }
+    }
+};
+
+const char* operationName(OpCache::Operation op) {
+    switch (op) {
+    case OpCache::Determinize:
+        return "det";
+    case OpCache::Complement:
+        return "cmp";
+    case OpCache::Intersection:
+        return "inter";
+    case OpCache::Trim:
+        return "trim";
+    default:
+        return "min";
+    }
+}
+
+void writeAutomaton(ostream& os, const Automaton& aut) {
+    os << "automaton 1\n" << aut.size() << "\n";
+    os << aut.get_inits().size();
+    for (int q : aut.get_inits()) {
+        os << " " << q;
+    }
+    os << "\n" << aut.get_finals().size();
+    for (int q : aut.get_finals()) {
+        os << " " << q;
+    }
+    os << "\n" << aut.get_alphabet().size();
+    for (char c : aut.get_alphabet()) {
+        os << " " << static_cast<int>(c);
+    }
+    os << "\n" << aut.get_trans().size() << "\n";
+    for (const auto& t : aut.get_trans()) {
+        os << get<0>(t) << " " << static_cast<int>(get<1>(t)) << " " << get<2>(t) << "\n";
+    }
+}
+
+bool readAutomaton(istream& is, Automaton& aut) {
+    string magic;
+    int version, nb_states;
+    size_t n;
+    if (!(is >> magic >> version >> nb_states) || magic != "automaton" || version != 1) {
+        return false;
+    }
+    Automaton result;
+    for (int q = 0; q < nb_states; ++q) {
+        result.newstate();
+    }
+    int q, c, dst;
+    is >> n;
+    for (size_t i = 0; i < n && is >> q; ++i) {
+        result.add_init(q);
+    }
+    is >> n;
+    for (size_t i = 0; i < n && is >> q; ++i) {
+        result.add_final_unchecked(q);
+    }
+    is >> n;
+    for (size_t i = 0; i < n && is >> c; ++i) {
+        result.add_letter(static_cast<char>(c));
+    }
+    is >> n;
+    for (size_t i = 0; i < n && is >> q >> c >> dst; ++i) {
+        result.add_trans_unchecked(q, static_cast<char>(c), dst);
+    }
+    if (!is) {
+        return false;
+    }
+    aut = result;
+    return true;
+}
+
+} // namespace
+
+string AutomatonHash::hex() const {
+    char buf[33];
+    snprintf(buf, sizeof(buf), "%016llx%016llx",
+             static_cast<unsigned long long>(h1), static_cast<unsigned long long>(h2));
+    return buf;
+}
+
+AutomatonHash structuralHash(const Automaton& aut) {
+    Hasher h;
+    h.feed(aut.size());
+    h.feedSet(vector<int>(aut.get_inits().begin(), aut.get_inits().end()));
+    h.feedSet(vector<int>(aut.get_finals().begin(), aut.get_finals().end()));
+    vector<unsigned char> letters;
+    for (char c : aut.get_alphabet()) {
+        letters.push_back(static_cast<unsigned char>(c));
+    }
+    h.feedSet(letters);
+
+    vector<tuple<int, unsigned char, int>> trans;
+    trans.reserve(aut.get_trans().size());
+    for (const auto& t : aut.get_trans()) {
+        trans.emplace_back(get<0>(t), static_cast<unsigned char>(get<1>(t)), get<2>(t));
+    }
+    sort(trans.begin(), trans.end());
+    h.feed(trans.size());
+    for (const auto& t : trans) {
+        h.feed(static_cast<uint32_t>(get<0>(t)));
+        h.feed(get<1>(t));
+        h.feed(static_cast<uint32_t>(get<2>(t)));
+    }
+    return {h.h1, h.h2};
+}
+
+OpCache::OpCache(size_t capacity, const string& directory)
+    : capacity(capacity), directory(directory), nb_hits(0), nb_misses(0) {
+    if (!directory.empty()) {
+        filesystem::create_directories(directory);
+    }
+}
+
+Automaton OpCache::get_or_compute(Operation op, const vector<AutomatonHash>& operands,
+                                  const function<Automaton()>& compute) {
+    return *get_shared(op, operands, compute);
+}
+
+shared_ptr<const Automaton> OpCache::get_shared(Operation op, const vector<AutomatonHash>& operands,
+                                                const function<Automaton()>& compute) {
+    string key = operationName(op);
+    for (const AutomatonHash& h : operands) {
+        key += "-" + h.hex();
+    }
+
+    shared_ptr<const Automaton> result = lookup(key);
+    if (result) {
+        return result;
+    }
+    // Le calcul se fait hors verrou : d'autres threads peuvent consulter le
+    // cache pendant ce temps.
+    result = make_shared<const Automaton>(compute());
+    insert(key, result);
+    return result;
+}
+
+shared_ptr<const Automaton> OpCache::determinize(const Automaton& aut) {
+    return determinize(aut, structuralHash(aut));
+}
+
+shared_ptr<const Automaton> OpCache::determinize(const Automaton& aut, const AutomatonHash& hash) {
+    return get_shared(Determinize, {hash}, [&aut]() { return ::determinize(aut); });
+}
+
+shared_ptr<const Automaton> OpCache::complement(const Automaton& aut) {
+    return complement(aut, structuralHash(aut));
+}
+
+shared_ptr<const Automaton> OpCache::complement(const Automaton& aut, const AutomatonHash& hash) {
+    return get_shared(Complement, {hash}, [&aut]() { return ::complement(aut); });
+}
+
+shared_ptr<const Automaton> OpCache::intersection(const Automaton& aut1, const Automaton& aut2) {
+    return intersection(aut1, structuralHash(aut1), aut2, structuralHash(aut2));
+}
+
+shared_ptr<const Automaton> OpCache::intersection(const Automaton& aut1, const AutomatonHash& hash1,
+                                                  const Automaton& aut2, const AutomatonHash& hash2) {
+    return get_shared(Intersection, {hash1, hash2},
+                      [&aut1, &aut2]() { return ::intersection(aut1, aut2); });
+}
+
+shared_ptr<const Automaton> OpCache::trim(const Automaton& aut) {
+    return trim(aut, structuralHash(aut));
+}
+
+shared_ptr<const Automaton> OpCache::trim(const Automaton& aut, const AutomatonHash& hash) {
+    return get_shared(Trim, {hash}, [&aut]() { return ::trim(aut); });
+}
+
+void OpCache::clear() {
+    lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+}
+
+size_t OpCache::size() const {
+    lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+size_t OpCache::hits() const {
+    lock_guard<std::mutex> lock(mutex);
+    return nb_hits;
+}
+
+size_t OpCache::misses() const {
+    lock_guard<std::mutex> lock(mutex);
+    return nb_misses;
+}
+
+MemoryUsage OpCache::memory_usage() const {
+    lock_guard<std::mutex> lock(mutex);
+    size_t used = 0;
+    size_t reserved = 0;
+    size_t keys = 0;
+    for (const Entry& e : lru) {
+        MemoryUsage result = e.second->memory_usage();
+        used += result.used();
+        reserved += result.reserved();
+        keys += e.first.capacity();
+    }
+    MemoryUsage usage;
+    usage.add("resultats", used, reserved);
+    // Noeuds de la liste (entrée et deux pointeurs) ; chaque clé est
+    // stockée dans la liste et dans l'index
+    size_t nodes = lru.size() * (sizeof(Entry) + 2 * sizeof(void*));
+    usage.add("lru", nodes + keys, nodes + keys);
+    usage.add_hash_map("index", index);
+    usage.add("cles de l'index", keys, keys);
+    return usage;
+}
+
+shared_ptr<const Automaton> OpCache::lookup(const string& key) {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+            ++nb_hits;
+            return it->second->second;
+        }
+    }
+    if (!directory.empty()) {
+        ifstream in(path(key));
+        Automaton stored;
+        if (in && readAutomaton(in, stored)) {
+            shared_ptr<const Automaton> result = make_shared<const Automaton>(move(stored));
+            insert(key, result);
+            lock_guard<std::mutex> lock(mutex);
+            ++nb_hits;
+            return result;
+        }
+    }
+    lock_guard<std::mutex> lock(mutex);
+    ++nb_misses;
+    return nullptr;
+}
+
+void OpCache::insert(const string& key, const shared_ptr<const Automaton>& aut) {
+    if (!directory.empty() && !filesystem::exists(path(key))) {
+        // Écriture dans un fichier temporaire puis renommage, pour qu'un
+        // lecteur concurrent ne voie jamais un fichier incomplet. Un fichier
+        // mal écrit (disque plein...) est supprimé : le résultat reste
+        // seulement en mémoire.
+        string tmp = path(key) + ".tmp" + to_string(hash<thread::id>()(this_thread::get_id()));
+        ofstream out(tmp);
+        writeAutomaton(out, *aut);
+        out.close();
+        error_code ec;
+        if (out) {
+            filesystem::rename(tmp, path(key), ec);
+        }
+        if (!out || ec) {
+            filesystem::remove(tmp, ec);
+        }
+    }
+
+    lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+    if (capacity == 0) {
+        return;
+    }
+    lru.emplace_front(key, aut);
+    index[key] = lru.begin();
+    while (lru.size() > capacity) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+    }
+}
+
+string OpCache::path(const string& key) const {
+    return (filesystem::path(directory) / (key + ".aut")).string();
+}
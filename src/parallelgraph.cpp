@@ -0,0 +1,595 @@
+#include "parallelgraph.h"
+#include "operations.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// Règle de Beamer pour le changement de sens des parcours
+const size_t alpha = 14;
+const size_t beta = 24;
+
+unsigned threadCount(unsigned nb_threads) {
+    return nb_threads != 0 ? nb_threads : max(1u, thread::hardware_concurrency());
+}
+
+ParallelOptions withThreads(unsigned nb_threads) {
+    ParallelOptions options;
+    options.nb_threads = nb_threads;
+    return options;
+}
+
+// Appelle f(begin, end, w) sur des tranches de [0, n), la w-ième dans son
+// propre thread. Les bornes sont multiples de 64 : un mot d'un ensemble de
+// bits indexé par état n'appartient qu'à une tranche.
+template <typename F>
+void parallelFor(size_t n, unsigned threads, size_t minSize, F f) {
+    if (threads <= 1 || n < minSize) {
+        f(size_t(0), n, 0u);
+        return;
+    }
+    size_t chunk = ((n + threads - 1) / threads + 63) / 64 * 64;
+    vector<thread> workers;
+    for (unsigned w = 0; w < threads && w * chunk < n; ++w) {
+        size_t begin = w * chunk;
+        size_t end = min(n, begin + chunk);
+        workers.emplace_back([&f, begin, end, w]() { f(begin, end, w); });
+    }
+    for (thread& t : workers) {
+        t.join();
+    }
+}
+
+class AtomicBitset {
+public:
+    explicit AtomicBitset(size_t n) : nb_words((n + 63) / 64), words(new atomic<uint64_t>[nb_words]) {
+        for (size_t i = 0; i < nb_words; ++i) {
+            words[i].store(0, memory_order_relaxed);
+        }
+    }
+
+    bool test(size_t i) const {
+        return (words[i / 64].load(memory_order_relaxed) >> (i % 64)) & 1;
+    }
+
+    // Vrai si le bit n'était pas encore mis
+    bool set(size_t i) {
+        uint64_t bit = uint64_t(1) << (i % 64);
+        return (words[i / 64].fetch_or(bit, memory_order_relaxed) & bit) == 0;
+    }
+
+private:
+    size_t nb_words;
+    unique_ptr<atomic<uint64_t>[]> words;
+};
+
+// Sens de parcours : les transitions suivies de haut en bas, et celles
+// remontées de bas en haut
+struct Direction {
+    const Adjacency& adj;
+    bool forward;
+
+    const Adjacency::Edge* begin(int q) const {
+        return forward ? adj.out_begin(q) : adj.in_begin(q);
+    }
+    const Adjacency::Edge* end(int q) const {
+        return forward ? adj.out_end(q) : adj.in_end(q);
+    }
+    const Adjacency::Edge* rbegin(int q) const {
+        return forward ? adj.in_begin(q) : adj.out_begin(q);
+    }
+    const Adjacency::Edge* rend(int q) const {
+        return forward ? adj.in_end(q) : adj.out_end(q);
+    }
+};
+
+// Marque dans visited les états atteints depuis srcs sans sortir des
+// états q tels que allowed(q). Les transitions de la frontière et celles
+// restant à examiner sont estimées par le degré moyen : relire le degré de
+// chaque état découvert coûterait un défaut de cache de plus.
+template <typename Allowed>
+void reach(const Direction& dir, const vector<int>& srcs, Allowed allowed, unsigned threads,
+           const ParallelOptions& options, AtomicBitset& visited) {
+    size_t n = static_cast<size_t>(dir.adj.size());
+    vector<int> frontier;
+    for (int q : srcs) {
+        if (allowed(q) && visited.set(q)) {
+            frontier.push_back(q);
+        }
+    }
+
+    vector<vector<int>> found(threads);
+    size_t unvisited = n - frontier.size();
+    bool bottomUp = false;
+    while (!frontier.empty()) {
+        if (!bottomUp && frontier.size() > unvisited / alpha) {
+            bottomUp = true;
+        } else if (bottomUp && frontier.size() < n / beta) {
+            bottomUp = false;
+        }
+        for (vector<int>& f : found) {
+            f.clear();
+        }
+
+        if (bottomUp) {
+            // Un état non visité est atteint s'il a un prédécesseur visité,
+            // de ce niveau ou d'un précédent
+            parallelFor(n, threads, options.min_parallel_states,
+                        [&](size_t begin, size_t end, unsigned w) {
+                for (size_t v = begin; v < end; ++v) {
+                    int q = static_cast<int>(v);
+                    if (visited.test(v) || !allowed(q)) {
+                        continue;
+                    }
+                    for (const Adjacency::Edge* e = dir.rbegin(q); e != dir.rend(q); ++e) {
+                        if (visited.test(e->state)) {
+                            visited.set(v);
+                            found[w].push_back(q);
+                            break;
+                        }
+                    }
+                }
+            });
+        } else {
+            parallelFor(frontier.size(), threads, options.min_parallel_frontier,
+                        [&](size_t begin, size_t end, unsigned w) {
+                for (size_t i = begin; i < end; ++i) {
+                    int q = frontier[i];
+                    for (const Adjacency::Edge* e = dir.begin(q); e != dir.end(q); ++e) {
+                        int r = e->state;
+                        if (!visited.test(r) && allowed(r) && visited.set(r)) {
+                            found[w].push_back(r);
+                        }
+                    }
+                }
+            });
+        }
+
+        frontier.clear();
+        for (const vector<int>& f : found) {
+            frontier.insert(frontier.end(), f.begin(), f.end());
+        }
+        unvisited -= frontier.size();
+    }
+}
+
+vector<bool> reachAll(const Adjacency& adj, bool forward, const IdxSet<int>& srcs,
+                      const ParallelOptions& options) {
+    unsigned threads = threadCount(options.nb_threads);
+    if (threads <= 1) {
+        // Sans thread supplémentaire, le parcours séquentiel évite les
+        // opérations atomiques et la synchronisation par niveau
+        return forward ? forwardReach(adj, srcs) : backwardReach(adj, srcs);
+    }
+    AtomicBitset visited(adj.size());
+    vector<int> sources(srcs.begin(), srcs.end());
+    reach(Direction{adj, forward}, sources, [](int) { return true; }, threads, options, visited);
+    vector<bool> result(adj.size());
+    for (int q = 0; q < adj.size(); ++q) {
+        result[q] = visited.test(q);
+    }
+    return result;
+}
+
+class SccSolver {
+public:
+    SccSolver(const Adjacency& adj, const ParallelOptions& options)
+        : adj(adj), n(adj.size()), threads(threadCount(options.nb_threads)), options(options),
+          color(new atomic<int>[adj.size()]),
+          comp(adj.size(), -1), index(adj.size(), -1), low(adj.size(), 0), mark(adj.size(), 0),
+          nextComp(0), nextColor(1), busy(0) {
+        for (int q = 0; q < n; ++q) {
+            color[q].store(0, memory_order_relaxed);
+        }
+    }
+
+    // wholeTarjan : une seule partie, tout le graphe, sans élagage ni FW-BW
+    SccDecomposition run(bool wholeTarjan) {
+        if (wholeTarjan) {
+            Part all{0, {}};
+            for (int q = 0; q < n; ++q) {
+                all.states.push_back(q);
+            }
+            parts.push_back(move(all));
+        } else {
+            trimTrivial();
+            splitGiant();
+        }
+        if (threads <= 1 || parts.empty()) {
+            work();
+        } else {
+            vector<thread> workers;
+            for (unsigned w = 0; w < threads; ++w) {
+                workers.emplace_back([this]() { work(); });
+            }
+            for (thread& t : workers) {
+                t.join();
+            }
+        }
+
+        // Numéros définitifs dans l'ordre du plus petit état de chaque
+        // composante : indépendants de l'ordre d'exécution des threads
+        SccDecomposition result;
+        result.component.resize(n);
+        vector<int> renumber(nextComp.load(), -1);
+        for (int q = 0; q < n; ++q) {
+            int& c = renumber[comp[q]];
+            if (c < 0) {
+                c = static_cast<int>(result.sizes.size());
+                result.sizes.push_back(0);
+            }
+            result.component[q] = c;
+            ++result.sizes[c];
+        }
+        return result;
+    }
+
+private:
+    // Partie du graphe réunissant des composantes entières
+    struct Part {
+        int color;
+        vector<int> states;
+        bool unbalanced = false;    // Issue d'une découpe presque sans effet
+    };
+
+    const Adjacency& adj;
+    int n;
+    unsigned threads;
+    ParallelOptions options;
+
+    // Partie contenant chaque état, -1 une fois sa composante trouvée.
+    // Les numéros de partie ne sont jamais réutilisés : un état voisin
+    // changeant de partie pendant qu'on le lit n'est jamais pris pour un
+    // état de la partie courante.
+    unique_ptr<atomic<int>[]> color;
+
+    // Écrits seulement par le thread qui traite la partie de l'état
+    vector<int> comp;           // Numéro provisoire de composante
+    vector<int> index;          // Tarjan
+    vector<int> low;
+    vector<uint8_t> mark;       // FW-BW : 1 atteint en avant, 2 en arrière
+
+    atomic<int> nextComp;
+    atomic<int> nextColor;
+
+    mutex m;
+    condition_variable cv;
+    vector<Part> parts;         // Parties en attente
+    int busy;                   // Parties en cours de traitement
+
+    bool live(int q, int c) const {
+        return color[q].load() == c;
+    }
+
+    void found(int q, int component) {
+        comp[q] = component;
+        color[q].store(-1);
+    }
+
+    // Étape 1 : états sans prédécesseur ou sans successeur restant (hors
+    // boucle), jusqu'à ce qu'un tour en retire moins d'un centième
+    void trimTrivial() {
+        int remaining = n;
+        vector<int> removed(threads);
+        while (remaining > 0) {
+            fill(removed.begin(), removed.end(), 0);
+            parallelFor(n, threads, options.min_parallel_states,
+                        [&](size_t begin, size_t end, unsigned w) {
+                for (size_t v = begin; v < end; ++v) {
+                    int q = static_cast<int>(v);
+                    if (!live(q, 0)) {
+                        continue;
+                    }
+                    if (!hasLiveNeighbour(q, adj.in_begin(q), adj.in_end(q))
+                        || !hasLiveNeighbour(q, adj.out_begin(q), adj.out_end(q))) {
+                        found(q, nextComp++);
+                        ++removed[w];
+                    }
+                }
+            });
+            int total = 0;
+            for (int r : removed) {
+                total += r;
+            }
+            remaining -= total;
+            if (total == 0 || total < remaining / 100) {
+                break;
+            }
+        }
+    }
+
+    bool hasLiveNeighbour(int q, const Adjacency::Edge* begin, const Adjacency::Edge* end) const {
+        for (const Adjacency::Edge* e = begin; e != end; ++e) {
+            if (e->state != q && live(e->state, 0)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Étape 2 : FW-BW parallèle depuis l'état restant de plus grand degré
+    void splitGiant() {
+        int pivot = -1;
+        size_t best = 0;
+        for (int q = 0; q < n; ++q) {
+            if (!live(q, 0)) {
+                continue;
+            }
+            size_t degree = static_cast<size_t>(adj.in_end(q) - adj.in_begin(q) + 1)
+                            * static_cast<size_t>(adj.out_end(q) - adj.out_begin(q) + 1);
+            if (pivot < 0 || degree > best) {
+                pivot = q;
+                best = degree;
+            }
+        }
+        if (pivot < 0) {
+            return;
+        }
+
+        auto allowed = [this](int q) { return live(q, 0); };
+        AtomicBitset forward(n);
+        AtomicBitset backward(n);
+        reach(Direction{adj, true}, {pivot}, allowed, threads, options, forward);
+        reach(Direction{adj, false}, {pivot}, allowed, threads, options, backward);
+
+        // Composante du pivot, puis les trois parties restantes
+        int pivotComp = nextComp++;
+        int colors[3] = {nextColor++, nextColor++, nextColor++};
+        vector<vector<vector<int>>> split(threads, vector<vector<int>>(3));
+        parallelFor(n, threads, options.min_parallel_states,
+                    [&](size_t begin, size_t end, unsigned w) {
+            for (size_t v = begin; v < end; ++v) {
+                int q = static_cast<int>(v);
+                if (!live(q, 0)) {
+                    continue;
+                }
+                bool f = forward.test(v);
+                bool b = backward.test(v);
+                if (f && b) {
+                    found(q, pivotComp);
+                    continue;
+                }
+                int k = f ? 0 : b ? 1 : 2;
+                color[q].store(colors[k]);
+                split[w][k].push_back(q);
+            }
+        });
+        for (int k = 0; k < 3; ++k) {
+            Part part{colors[k], {}};
+            for (unsigned w = 0; w < threads; ++w) {
+                part.states.insert(part.states.end(), split[w][k].begin(), split[w][k].end());
+            }
+            if (!part.states.empty()) {
+                parts.push_back(move(part));
+            }
+        }
+    }
+
+    // Étape 3 : traitement des parties en attente, jusqu'à ce qu'il n'y en
+    // ait plus aucune, en attente ou en cours
+    void work() {
+        unique_lock<mutex> lock(m);
+        while (true) {
+            cv.wait(lock, [this]() { return !parts.empty() || busy == 0; });
+            if (parts.empty()) {
+                return;
+            }
+            Part part = move(parts.back());
+            parts.pop_back();
+            ++busy;
+            lock.unlock();
+
+            vector<Part> created;
+            if (threads <= 1 || part.unbalanced || part.states.size() <= options.max_tarjan_part) {
+                tarjan(part);
+            } else {
+                fwbw(part, created);
+            }
+
+            lock.lock();
+            for (Part& p : created) {
+                parts.push_back(move(p));
+            }
+            --busy;
+            cv.notify_all();
+        }
+    }
+
+    // Tarjan itératif restreint à la partie. Un état déjà numéroté et
+    // toujours dans la partie est sur la pile : les autres ont reçu leur
+    // composante et sont sortis de la partie.
+    void tarjan(const Part& part) {
+        int c = part.color;
+        int counter = 0;
+        vector<int> stack;
+        vector<pair<int, const Adjacency::Edge*>> calls;
+        auto visit = [&](int v) {
+            index[v] = low[v] = counter++;
+            stack.push_back(v);
+            calls.emplace_back(v, adj.out_begin(v));
+        };
+        for (int s : part.states) {
+            if (index[s] >= 0) {
+                continue;
+            }
+            visit(s);
+            while (!calls.empty()) {
+                int v = calls.back().first;
+                const Adjacency::Edge* e = calls.back().second;
+                if (e != adj.out_end(v)) {
+                    calls.back().second = e + 1;
+                    int w = e->state;
+                    if (!live(w, c)) {
+                        continue;
+                    }
+                    if (index[w] < 0) {
+                        visit(w);
+                    } else {
+                        low[v] = min(low[v], index[w]);
+                    }
+                    continue;
+                }
+                calls.pop_back();
+                if (low[v] == index[v]) {
+                    int id = nextComp++;
+                    int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        found(w, id);
+                    } while (w != v);
+                }
+                if (!calls.empty()) {
+                    int u = calls.back().first;
+                    low[u] = min(low[u], low[v]);
+                }
+            }
+        }
+    }
+
+    // Parcours séquentiel restreint à la partie c, marqué par bit
+    void markReach(int pivot, int c, bool forward, uint8_t bit) {
+        vector<int> queue(1, pivot);
+        mark[pivot] |= bit;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int q = queue[head];
+            const Adjacency::Edge* begin = forward ? adj.out_begin(q) : adj.in_begin(q);
+            const Adjacency::Edge* end = forward ? adj.out_end(q) : adj.in_end(q);
+            for (const Adjacency::Edge* e = begin; e != end; ++e) {
+                int r = e->state;
+                if ((mark[r] & bit) == 0 && live(r, c)) {
+                    mark[r] |= bit;
+                    queue.push_back(r);
+                }
+            }
+        }
+    }
+
+    // FW-BW séquentiel : la composante du pivot et trois nouvelles parties.
+    // Sur une chaîne de petites composantes, chaque découpe ne détache que
+    // celle du pivot et les découpes successives coûtent un temps
+    // quadratique : une partie gardant presque tous les états de la partie
+    // découpée est laissée à Tarjan.
+    void fwbw(const Part& part, vector<Part>& created) {
+        int pivot = part.states.front();
+        markReach(pivot, part.color, true, 1);
+        markReach(pivot, part.color, false, 2);
+        int pivotComp = nextComp++;
+        Part split[3];
+        for (int q : part.states) {
+            uint8_t k = mark[q];
+            mark[q] = 0;
+            if (k == 3) {
+                found(q, pivotComp);
+            } else {
+                split[k == 1 ? 0 : k == 2 ? 1 : 2].states.push_back(q);
+            }
+        }
+        for (Part& p : split) {
+            if (p.states.empty()) {
+                continue;
+            }
+            p.unbalanced = p.states.size() > part.states.size() - part.states.size() / 8;
+            p.color = nextColor++;
+            for (int q : p.states) {
+                color[q].store(p.color);
+            }
+            created.push_back(move(p));
+        }
+    }
+};
+
+} // namespace
+
+vector<bool> parallelForwardReach(const Adjacency& adj, const IdxSet<int>& srcs, unsigned nb_threads) {
+    return reachAll(adj, true, srcs, withThreads(nb_threads));
+}
+
+vector<bool> parallelBackwardReach(const Adjacency& adj, const IdxSet<int>& srcs, unsigned nb_threads) {
+    return reachAll(adj, false, srcs, withThreads(nb_threads));
+}
+
+vector<bool> parallelForwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                  const ParallelOptions& options) {
+    return reachAll(adj, true, srcs, options);
+}
+
+vector<bool> parallelBackwardReach(const Adjacency& adj, const IdxSet<int>& srcs,
+                                   const ParallelOptions& options) {
+    return reachAll(adj, false, srcs, options);
+}
+
+int SccDecomposition::count() const {
+    return static_cast<int>(sizes.size());
+}
+
+SccDecomposition parallelScc(const Adjacency& adj, unsigned nb_threads) {
+    return parallelScc(adj, withThreads(nb_threads));
+}
+
+SccDecomposition parallelScc(const Adjacency& adj, const ParallelOptions& options) {
+    SccSolver solver(adj, options);
+    return solver.run(false);
+}
+
+SccDecomposition tarjanScc(const Adjacency& adj) {
+    SccSolver solver(adj, withThreads(1));
+    return solver.run(true);
+}
+
+namespace {
+
+// États accessibles et co-accessibles
+vector<bool> usefulStates(const Automaton& aut, const Adjacency& adj, unsigned nb_threads) {
+    vector<bool> useful = parallelForwardReach(adj, aut.get_inits(), nb_threads);
+    vector<bool> coaccessible = parallelBackwardReach(adj, aut.get_finals(), nb_threads);
+    for (int q = 0; q < aut.size(); ++q) {
+        useful[q] = useful[q] && coaccessible[q];
+    }
+    return useful;
+}
+
+} // namespace
+
+Automaton parallelTrim(const Automaton& aut, vector<int>& old2new, unsigned nb_threads) {
+    Adjacency adj(aut);
+    return restrictStates(aut, usefulStates(aut, adj, nb_threads), old2new);
+}
+
+bool parallelEmptyLanguage(const Automaton& aut, unsigned nb_threads) {
+    Adjacency adj(aut);
+    vector<bool> accessible = parallelForwardReach(adj, aut.get_inits(), nb_threads);
+    for (int q : aut.get_finals()) {
+        if (accessible[q]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool infiniteLanguage(const Automaton& aut, unsigned nb_threads) {
+    Adjacency adj(aut);
+    vector<bool> useful = usefulStates(aut, adj, nb_threads);
+    SccDecomposition scc = parallelScc(adj, nb_threads);
+    for (int q = 0; q < aut.size(); ++q) {
+        if (!useful[q]) {
+            continue;
+        }
+        if (scc.sizes[scc.component[q]] > 1) {
+            return true;
+        }
+        for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+            if (e->state == q) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,218 @@
+#include "product.h"
+#include "adjacency.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+
+// En dessous de cette taille, un niveau est traité sans créer de threads.
+const size_t minParallelFrontier = 1024;
+
+// Données d'un opérande utiles au produit
+struct Operand {
+    Adjacency adj;
+    vector<bool> useful;    // co-accessible
+    vector<bool> final;
+
+    explicit Operand(const Automaton& aut)
+        : adj(aut), useful(backwardReach(adj, aut.get_finals())), final(aut.size(), false) {
+        for (int q : aut.get_finals()) {
+            final[q] = true;
+        }
+    }
+};
+
+// Successeurs calculés par un thread : la transition (src, letter) mène au
+// k-uplet stocké dans tuples à partir de k * i.
+struct Successors {
+    vector<int> src;
+    vector<char> letter;
+    vector<int> tuples;
+};
+
+class Product {
+public:
+    Product(const vector<Automaton>& auts, unsigned nb_threads)
+        : k(auts.size()), nb_threads(nb_threads), ids(0, TupleHash{this}, TupleEqual{this}) {
+        for (const Automaton& aut : auts) {
+            operands.emplace_back(aut);
+        }
+        if (this->nb_threads == 0) {
+            this->nb_threads = max(1u, thread::hardware_concurrency());
+        }
+    }
+
+    Automaton run(const vector<Automaton>& auts) {
+        // k-uplets initiaux : produit cartésien des états initiaux utiles
+        vector<vector<int>> inits(k);
+        for (size_t i = 0; i < k; ++i) {
+            for (int q : auts[i].get_inits()) {
+                if (operands[i].useful[q]) {
+                    inits[i].push_back(q);
+                }
+            }
+        }
+        vector<int> current(k);
+        vector<int> frontier;
+        forEachTuple(inits, current, 0, [&](const vector<int>& t) {
+            bool isNew;
+            int id = intern(t.data(), isNew);
+            result.add_init(id);
+            frontier.push_back(id);
+        });
+
+        while (!frontier.empty()) {
+            vector<Successors> parts(frontier.size() < minParallelFrontier ? 1 : nb_threads);
+            if (parts.size() == 1) {
+                expand(frontier, 0, frontier.size(), parts[0]);
+            } else {
+                vector<thread> workers;
+                size_t chunk = (frontier.size() + parts.size() - 1) / parts.size();
+                for (size_t w = 0; w < parts.size(); ++w) {
+                    size_t begin = min(frontier.size(), w * chunk);
+                    size_t end = min(frontier.size(), begin + chunk);
+                    workers.emplace_back([this, &frontier, begin, end, &parts, w]() {
+                        expand(frontier, begin, end, parts[w]);
+                    });
+                }
+                for (thread& t : workers) {
+                    t.join();
+                }
+            }
+
+            // Numérotation séquentielle, dans l'ordre des threads
+            vector<int> next;
+            for (const Successors& part : parts) {
+                for (size_t i = 0; i < part.src.size(); ++i) {
+                    bool isNew;
+                    int id = intern(&part.tuples[k * i], isNew);
+                    if (isNew) {
+                        next.push_back(id);
+                    }
+                    // Pour une source et une lettre données, les k-uplets
+                    // produits sont distincts : pas de test d'appartenance.
+                    result.add_trans_unchecked(part.src[i], part.letter[i], id);
+                }
+            }
+            frontier.swap(next);
+        }
+        return result;
+    }
+
+private:
+    struct TupleHash {
+        const Product* p;
+        size_t operator()(int id) const {
+            const int* t = p->tuple(id);
+            size_t h = 0;
+            for (size_t i = 0; i < p->k; ++i) {
+                h = (h ^ static_cast<size_t>(t[i])) * 0x100000001b3ULL;
+            }
+            return h;
+        }
+    };
+
+    struct TupleEqual {
+        const Product* p;
+        bool operator()(int a, int b) const {
+            return equal(p->tuple(a), p->tuple(a) + p->k, p->tuple(b));
+        }
+    };
+
+    size_t k;
+    unsigned nb_threads;
+    vector<Operand> operands;
+    vector<int> tuples;     // k-uplets mis bout à bout, indexés par état du produit
+    unordered_set<int, TupleHash, TupleEqual> ids;
+    Automaton result;
+
+    const int* tuple(int id) const {
+        return tuples.data() + k * static_cast<size_t>(id);
+    }
+
+    // Retourne le numéro du k-uplet t, en le créant s'il est nouveau.
+    int intern(const int* t, bool& isNew) {
+        int id = static_cast<int>(tuples.size() / k);
+        tuples.insert(tuples.end(), t, t + k);
+        auto found = ids.insert(id);
+        isNew = found.second;
+        if (!isNew) {
+            tuples.resize(tuples.size() - k);
+            return *found.first;
+        }
+        result.newstate();
+        bool final = true;
+        for (size_t i = 0; i < k && final; ++i) {
+            final = operands[i].final[t[i]];
+        }
+        if (final) {
+            result.add_final_unchecked(id);
+        }
+        return id;
+    }
+
+    // Calcule les successeurs utiles des états frontier[begin..end[.
+    // Ne fait que lire tuples et operands : peut tourner en parallèle.
+    void expand(const vector<int>& frontier, size_t begin, size_t end, Successors& out) const {
+        vector<vector<int>> dsts(k);
+        vector<int> current(k);
+        for (size_t f = begin; f < end; ++f) {
+            int id = frontier[f];
+            const int* t = tuple(id);
+            const Adjacency& adj0 = operands[0].adj;
+            const Adjacency::Edge* e = adj0.out_begin(t[0]);
+            while (e != adj0.out_end(t[0])) {
+                char c = e->letter;
+                bool possible = true;
+                for (size_t i = 0; i < k && possible; ++i) {
+                    dsts[i].clear();
+                    auto range = operands[i].adj.out(t[i], c);
+                    for (const Adjacency::Edge* d = range.first; d != range.second; ++d) {
+                        if (operands[i].useful[d->state]) {
+                            dsts[i].push_back(d->state);
+                        }
+                    }
+                    possible = !dsts[i].empty();
+                }
+                if (possible) {
+                    forEachTuple(dsts, current, 0, [&](const vector<int>& s) {
+                        out.src.push_back(id);
+                        out.letter.push_back(c);
+                        out.tuples.insert(out.tuples.end(), s.begin(), s.end());
+                    });
+                }
+                // Lettre suivante
+                while (e != adj0.out_end(t[0]) && e->letter == c) {
+                    ++e;
+                }
+            }
+        }
+    }
+
+    // Appelle f sur chaque élément du produit cartésien des choices[i]
+    template <typename F>
+    static void forEachTuple(const vector<vector<int>>& choices, vector<int>& current,
+                             size_t i, F f) {
+        if (i == choices.size()) {
+            f(current);
+            return;
+        }
+        for (int q : choices[i]) {
+            current[i] = q;
+            forEachTuple(choices, current, i + 1, f);
+        }
+    }
+};
+
+} // namespace
+
+Automaton intersection(const vector<Automaton>& auts, unsigned nb_threads) {
+    if (auts.empty()) {
+        throw invalid_argument("intersection : aucun automate");
+    }
+    return Product(auts, nb_threads).run(auts);
+}
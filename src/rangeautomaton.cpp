@@ -0,0 +1,498 @@
+#include "rangeautomaton.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+using namespace std;
+
+RangeSet::RangeSet(char32_t lo, char32_t hi) {
+    add(lo, hi);
+}
+
+RangeSet RangeSet::all() {
+    return RangeSet(0, maxCodePoint);
+}
+
+void RangeSet::add(char32_t lo, char32_t hi) {
+    if (lo > hi || hi > maxCodePoint) {
+        throw invalid_argument("RangeSet::add : intervalle invalide");
+    }
+    // Premier intervalle qui touche ou suit [lo, hi]
+    auto first = lower_bound(intervals.begin(), intervals.end(), lo,
+                             [](const CodeRange& r, char32_t v) { return r.hi + 1 < v; });
+    auto last = first;
+    while (last != intervals.end() && last->lo <= hi + 1) {
+        lo = min(lo, last->lo);
+        hi = max(hi, last->hi);
+        ++last;
+    }
+    first = intervals.erase(first, last);
+    intervals.insert(first, CodeRange{lo, hi});
+}
+
+void RangeSet::add(const RangeSet& other) {
+    for (const CodeRange& r : other.intervals) {
+        add(r.lo, r.hi);
+    }
+}
+
+bool RangeSet::contains(char32_t c) const {
+    auto it = upper_bound(intervals.begin(), intervals.end(), c,
+                          [](char32_t v, const CodeRange& r) { return v < r.lo; });
+    return it != intervals.begin() && c <= prev(it)->hi;
+}
+
+bool RangeSet::empty() const {
+    return intervals.empty();
+}
+
+RangeSet RangeSet::intersect(const RangeSet& other) const {
+    RangeSet result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < intervals.size() && j < other.intervals.size()) {
+        const CodeRange& a = intervals[i];
+        const CodeRange& b = other.intervals[j];
+        char32_t lo = max(a.lo, b.lo);
+        char32_t hi = min(a.hi, b.hi);
+        if (lo <= hi) {
+            result.intervals.push_back({lo, hi});
+        }
+        if (a.hi < b.hi) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return result;
+}
+
+RangeSet RangeSet::complement() const {
+    RangeSet result;
+    char32_t next = 0;
+    for (const CodeRange& r : intervals) {
+        if (r.lo > next) {
+            result.intervals.push_back({next, r.lo - 1});
+        }
+        next = r.hi + 1;
+    }
+    if (next <= maxCodePoint) {
+        result.intervals.push_back({next, maxCodePoint});
+    }
+    return result;
+}
+
+const vector<CodeRange>& RangeSet::ranges() const {
+    return intervals;
+}
+
+bool RangeSet::operator==(const RangeSet& other) const {
+    return intervals.size() == other.intervals.size()
+           && equal(intervals.begin(), intervals.end(), other.intervals.begin(),
+                    [](const CodeRange& a, const CodeRange& b) { return a.lo == b.lo && a.hi == b.hi; });
+}
+
+namespace {
+
+string codePointString(char32_t c) {
+    if (c >= 0x21 && c <= 0x7E && c != '-' && c != '[' && c != ']' && c != '\\') {
+        return string(1, static_cast<char>(c));
+    }
+    char buf[16];
+    snprintf(buf, sizeof(buf), "\\x{%X}", static_cast<unsigned>(c));
+    return buf;
+}
+
+} // namespace
+
+string RangeSet::to_string() const {
+    string s = "[";
+    for (const CodeRange& r : intervals) {
+        s += codePointString(r.lo);
+        if (r.hi != r.lo) {
+            s += "-" + codePointString(r.hi);
+        }
+    }
+    return s + "]";
+}
+
+RangeAutomaton::RangeAutomaton(const Automaton& aut) {
+    for (int q = 0; q < aut.size(); ++q) {
+        newstate();
+    }
+    for (int q : aut.get_inits()) {
+        add_init(q);
+    }
+    for (int q : aut.get_finals()) {
+        add_final(q);
+    }
+    // Regroupe les lettres par couple (source, destination) avant l'ajout
+    map<pair<int, int>, RangeSet> labels;
+    for (const auto& t : aut.get_trans()) {
+        char32_t c = static_cast<unsigned char>(get<1>(t));
+        labels[make_pair(get<0>(t), get<2>(t))].add(c, c);
+    }
+    for (const auto& l : labels) {
+        transitions[l.first.first].push_back({l.second, l.first.second});
+    }
+}
+
+int RangeAutomaton::size() const {
+    return static_cast<int>(transitions.size());
+}
+
+int RangeAutomaton::newstate() {
+    transitions.emplace_back();
+    finals.push_back(false);
+    return size() - 1;
+}
+
+void RangeAutomaton::add_init(int q) {
+    if (q < 0 || q >= size()) {
+        throw out_of_range("RangeAutomaton::add_init : état inexistant");
+    }
+    if (find(inits.begin(), inits.end(), q) == inits.end()) {
+        inits.push_back(q);
+    }
+}
+
+void RangeAutomaton::add_final(int q) {
+    if (q < 0 || q >= size()) {
+        throw out_of_range("RangeAutomaton::add_final : état inexistant");
+    }
+    finals[q] = true;
+}
+
+void RangeAutomaton::add_trans(int src, const RangeSet& label, int dst) {
+    if (src < 0 || src >= size() || dst < 0 || dst >= size()) {
+        throw out_of_range("RangeAutomaton::add_trans : état inexistant");
+    }
+    if (label.empty()) {
+        return;
+    }
+    for (Transition& t : transitions[src]) {
+        if (t.dst == dst) {
+            t.label.add(label);
+            return;
+        }
+    }
+    transitions[src].push_back({label, dst});
+}
+
+void RangeAutomaton::add_trans(int src, char32_t lo, char32_t hi, int dst) {
+    add_trans(src, RangeSet(lo, hi), dst);
+}
+
+const vector<int>& RangeAutomaton::get_inits() const {
+    return inits;
+}
+
+bool RangeAutomaton::is_final(int q) const {
+    return finals[q];
+}
+
+const vector<RangeAutomaton::Transition>& RangeAutomaton::out(int q) const {
+    return transitions[q];
+}
+
+size_t RangeAutomaton::nb_transitions() const {
+    size_t n = 0;
+    for (const auto& out : transitions) {
+        n += out.size();
+    }
+    return n;
+}
+
+namespace {
+
+// Fait avancer l'ensemble d'états current par c ; mark est remis à zéro
+bool step(const RangeAutomaton& aut, vector<int>& current, vector<bool>& mark, char32_t c) {
+    vector<int> next;
+    for (int q : current) {
+        for (const RangeAutomaton::Transition& t : aut.out(q)) {
+            if (!mark[t.dst] && t.label.contains(c)) {
+                mark[t.dst] = true;
+                next.push_back(t.dst);
+            }
+        }
+    }
+    for (int q : next) {
+        mark[q] = false;
+    }
+    current.swap(next);
+    return !current.empty();
+}
+
+bool anyFinal(const RangeAutomaton& aut, const vector<int>& current) {
+    for (int q : current) {
+        if (aut.is_final(q)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool RangeAutomaton::appartient(const u32string& word) const {
+    vector<int> current = inits;
+    vector<bool> mark(size(), false);
+    for (char32_t c : word) {
+        if (!step(*this, current, mark, c)) {
+            return false;
+        }
+    }
+    return anyFinal(*this, current);
+}
+
+bool RangeAutomaton::appartientUtf8(const string& word) const {
+    vector<int> current = inits;
+    vector<bool> mark(size(), false);
+    size_t pos = 0;
+    char32_t c;
+    while (pos < word.size()) {
+        if (!decodeUtf8(word, pos, c) || !step(*this, current, mark, c)) {
+            return false;
+        }
+    }
+    return anyFinal(*this, current);
+}
+
+MemoryUsage RangeAutomaton::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("inits", inits);
+    usage.add_vector("finals", finals);
+    size_t used = transitions.size() * sizeof(vector<Transition>);
+    size_t reserved = transitions.capacity() * sizeof(vector<Transition>);
+    size_t labelsUsed = 0;
+    size_t labelsReserved = 0;
+    for (const auto& out : transitions) {
+        used += out.size() * sizeof(Transition);
+        reserved += out.capacity() * sizeof(Transition);
+        for (const Transition& t : out) {
+            labelsUsed += t.label.ranges().size() * sizeof(CodeRange);
+            labelsReserved += t.label.ranges().capacity() * sizeof(CodeRange);
+        }
+    }
+    usage.add("transitions", used, reserved);
+    usage.add("labels", labelsUsed, labelsReserved);
+    return usage;
+}
+
+void RangeAutomaton::print() const {
+    cout << "Number of states: " << size() << endl;
+    cout << "Initial states: { ";
+    for (int q : inits) {
+        cout << q << " ";
+    }
+    cout << "}" << endl;
+    cout << "Transitions: {" << endl;
+    for (int q = 0; q < size(); ++q) {
+        for (const Transition& t : transitions[q]) {
+            cout << "  " << q << " -" << t.label.to_string() << "-> " << t.dst << endl;
+        }
+    }
+    cout << "}" << endl;
+    cout << "Final states: { ";
+    for (int q = 0; q < size(); ++q) {
+        if (finals[q]) {
+            cout << q << " ";
+        }
+    }
+    cout << "}" << endl;
+}
+
+bool decodeUtf8(const string& s, size_t& pos, char32_t& c) {
+    unsigned char b = static_cast<unsigned char>(s[pos]);
+    if (b < 0x80) {
+        c = b;
+        ++pos;
+        return true;
+    }
+    size_t len;
+    char32_t min;
+    if ((b & 0xE0) == 0xC0) {
+        len = 2;
+        min = 0x80;
+        c = b & 0x1F;
+    } else if ((b & 0xF0) == 0xE0) {
+        len = 3;
+        min = 0x800;
+        c = b & 0x0F;
+    } else if ((b & 0xF8) == 0xF0) {
+        len = 4;
+        min = 0x10000;
+        c = b & 0x07;
+    } else {
+        return false;
+    }
+    if (s.size() - pos < len) {
+        return false;
+    }
+    for (size_t k = 1; k < len; ++k) {
+        unsigned char cont = static_cast<unsigned char>(s[pos + k]);
+        if ((cont & 0xC0) != 0x80) {
+            return false;
+        }
+        c = (c << 6) | (cont & 0x3F);
+    }
+    if (c < min || c > maxCodePoint || (c >= 0xD800 && c <= 0xDFFF)) {
+        return false;
+    }
+    pos += len;
+    return true;
+}
+
+namespace {
+
+// Partition minimale des étiquettes sortantes de l'ensemble d'états
+// subset : un RangeSet par ensemble de destinations, dans l'ordre du
+// premier point de code qui y mène.
+vector<pair<vector<int>, RangeSet>> partition(const RangeAutomaton& aut, const vector<int>& subset) {
+    // (point, +1/-1, destination) : la destination devient active ou
+    // inactive à partir de ce point
+    vector<tuple<char32_t, int, int>> events;
+    for (int q : subset) {
+        for (const RangeAutomaton::Transition& t : aut.out(q)) {
+            for (const CodeRange& r : t.label.ranges()) {
+                events.emplace_back(r.lo, 1, t.dst);
+                events.emplace_back(r.hi + 1, -1, t.dst);
+            }
+        }
+    }
+    sort(events.begin(), events.end());
+
+    vector<pair<vector<int>, RangeSet>> result;
+    map<vector<int>, size_t> index;
+    map<int, int> active;       // destination -> nombre d'intervalles ouverts
+    for (size_t i = 0; i < events.size();) {
+        char32_t point = get<0>(events[i]);
+        for (; i < events.size() && get<0>(events[i]) == point; ++i) {
+            int dst = get<2>(events[i]);
+            if ((active[dst] += get<1>(events[i])) == 0) {
+                active.erase(dst);
+            }
+        }
+        if (active.empty() || i == events.size()) {
+            continue;
+        }
+        vector<int> targets;
+        for (const auto& a : active) {
+            targets.push_back(a.first);
+        }
+        auto it = index.find(targets);
+        if (it == index.end()) {
+            it = index.emplace(targets, result.size()).first;
+            result.emplace_back(targets, RangeSet());
+        }
+        result[it->second].second.add(point, get<0>(events[i]) - 1);
+    }
+    return result;
+}
+
+} // namespace
+
+RangeAutomaton determinize(const RangeAutomaton& aut) {
+    RangeAutomaton result;
+    vector<vector<int>> subsets;
+    map<vector<int>, int> ids;
+    auto intern = [&](const vector<int>& s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = result.newstate();
+        subsets.push_back(s);
+        ids.emplace(s, id);
+        for (int q : s) {
+            if (aut.is_final(q)) {
+                result.add_final(id);
+                break;
+            }
+        }
+        return id;
+    };
+
+    vector<int> init = aut.get_inits();
+    sort(init.begin(), init.end());
+    result.add_init(intern(init));
+    for (size_t s = 0; s < subsets.size(); ++s) {
+        vector<int> subset = subsets[s];
+        for (const auto& part : partition(aut, subset)) {
+            result.add_trans(static_cast<int>(s), part.second, intern(part.first));
+        }
+    }
+    return result;
+}
+
+RangeAutomaton intersection(const RangeAutomaton& a, const RangeAutomaton& b) {
+    RangeAutomaton result;
+    vector<pair<int, int>> pairs;
+    map<pair<int, int>, int> ids;
+    auto intern = [&](int p, int q) {
+        auto it = ids.find(make_pair(p, q));
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = result.newstate();
+        pairs.emplace_back(p, q);
+        ids.emplace(make_pair(p, q), id);
+        if (a.is_final(p) && b.is_final(q)) {
+            result.add_final(id);
+        }
+        return id;
+    };
+
+    for (int p : a.get_inits()) {
+        for (int q : b.get_inits()) {
+            result.add_init(intern(p, q));
+        }
+    }
+    for (size_t s = 0; s < pairs.size(); ++s) {
+        int p = pairs[s].first;
+        int q = pairs[s].second;
+        for (const RangeAutomaton::Transition& ta : a.out(p)) {
+            for (const RangeAutomaton::Transition& tb : b.out(q)) {
+                RangeSet label = ta.label.intersect(tb.label);
+                if (!label.empty()) {
+                    result.add_trans(static_cast<int>(s), label, intern(ta.dst, tb.dst));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+RangeAutomaton complement(const RangeAutomaton& aut) {
+    RangeAutomaton det = determinize(aut);
+    RangeAutomaton result;
+    for (int q = 0; q < det.size(); ++q) {
+        result.newstate();
+        if (!det.is_final(q)) {
+            result.add_final(q);
+        }
+    }
+    for (int q : det.get_inits()) {
+        result.add_init(q);
+    }
+    int sink = -1;
+    for (int q = 0; q < det.size(); ++q) {
+        RangeSet covered;
+        for (const RangeAutomaton::Transition& t : det.out(q)) {
+            result.add_trans(q, t.label, t.dst);
+            covered.add(t.label);
+        }
+        RangeSet missing = covered.complement();
+        if (!missing.empty()) {
+            if (sink < 0) {
+                sink = result.newstate();
+                result.add_final(sink);
+                result.add_trans(sink, RangeSet::all(), sink);
+            }
+            result.add_trans(q, missing, sink);
+        }
+    }
+    return result;
+}
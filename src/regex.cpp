@@ -0,0 +1,259 @@
+#include "regex.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// Premier et dernier caractères de l'univers utilisé par '.' et '[^...]'
+const char firstPrintable = ' ';
+const char lastPrintable = '~';
+
+// Attributs de Glushkov d'une sous-expression : peut-elle produire le mot
+// vide, par quelles positions peut-elle commencer et finir.
+struct Fragment {
+    bool nullable = true;
+    vector<int> first;
+    vector<int> last;
+};
+
+// Analyseur descendant récursif qui calcule directement les ensembles
+// first/last/follow sans construire d'arbre syntaxique.
+class GlushkovParser {
+public:
+    explicit GlushkovParser(const string& regex) : re(regex), pos(0) {
+        // La position 0 est réservée à l'état initial
+        letters.emplace_back();
+        follow.emplace_back();
+    }
+
+    Automaton compile() {
+        Fragment f = parseUnion();
+        if (pos < re.size()) {
+            error("')' inattendue");
+        }
+
+        // Les ensembles follow peuvent contenir des doublons, issus par
+        // exemple de (a*)*. On les supprime pour pouvoir ajouter les
+        // transitions sans test d'appartenance.
+        for (auto& fl : follow) {
+            sort(fl.begin(), fl.end());
+            fl.erase(unique(fl.begin(), fl.end()), fl.end());
+        }
+        sort(f.first.begin(), f.first.end());
+        f.first.erase(unique(f.first.begin(), f.first.end()), f.first.end());
+        sort(f.last.begin(), f.last.end());
+        f.last.erase(unique(f.last.begin(), f.last.end()), f.last.end());
+
+        Automaton aut;
+        aut.add_init(aut.newstate());
+        for (size_t p = 1; p < letters.size(); ++p) {
+            aut.newstate();
+        }
+        for (int p : f.first) {
+            for (char c : letters[p]) {
+                aut.add_trans_unchecked(0, c, p);
+            }
+        }
+        for (size_t p = 1; p < follow.size(); ++p) {
+            for (int q : follow[p]) {
+                for (char c : letters[q]) {
+                    aut.add_trans_unchecked(static_cast<int>(p), c, q);
+                }
+            }
+        }
+        for (int p : f.last) {
+            aut.add_final(p);
+        }
+        if (f.nullable) {
+            aut.add_final(0);
+        }
+        return aut;
+    }
+
+private:
+    const string& re;
+    size_t pos;
+    vector<vector<char>> letters;   // Lettres étiquetant chaque position
+    vector<vector<int>> follow;     // follow[p] : positions pouvant suivre p
+
+    [[noreturn]] void error(const string& msg) const {
+        throw invalid_argument("Expression régulière invalide (caractère "
+                               + to_string(pos) + ") : " + msg);
+    }
+
+    bool atEnd() const {
+        return pos >= re.size();
+    }
+
+    void addFollow(const vector<int>& from, const vector<int>& to) {
+        for (int p : from) {
+            follow[p].insert(follow[p].end(), to.begin(), to.end());
+        }
+    }
+
+    // union := concat ('|' concat)*
+    Fragment parseUnion() {
+        Fragment f = parseConcat();
+        while (!atEnd() && re[pos] == '|') {
+            ++pos;
+            Fragment g = parseConcat();
+            f.nullable = f.nullable || g.nullable;
+            f.first.insert(f.first.end(), g.first.begin(), g.first.end());
+            f.last.insert(f.last.end(), g.last.begin(), g.last.end());
+        }
+        return f;
+    }
+
+    // concat := repeat*
+    Fragment parseConcat() {
+        Fragment f; // Le mot vide
+        while (!atEnd() && re[pos] != '|' && re[pos] != ')') {
+            Fragment g = parseRepeat();
+            addFollow(f.last, g.first);
+            if (f.nullable) {
+                f.first.insert(f.first.end(), g.first.begin(), g.first.end());
+            }
+            if (g.nullable) {
+                g.last.insert(g.last.end(), f.last.begin(), f.last.end());
+            }
+            f.last = std::move(g.last);
+            f.nullable = f.nullable && g.nullable;
+        }
+        return f;
+    }
+
+    // repeat := atom ('*' | '+' | '?')*
+    Fragment parseRepeat() {
+        Fragment f = parseAtom();
+        while (!atEnd() && (re[pos] == '*' || re[pos] == '+' || re[pos] == '?')) {
+            char op = re[pos++];
+            if (op != '?') {
+                addFollow(f.last, f.first);
+            }
+            if (op != '+') {
+                f.nullable = true;
+            }
+        }
+        return f;
+    }
+
+    // atom := '(' union ')' | '[' classe ']' | '.' | '\' c | c
+    Fragment parseAtom() {
+        char c = re[pos];
+        switch (c) {
+        case '(': {
+            ++pos;
+            Fragment f = parseUnion();
+            if (atEnd() || re[pos] != ')') {
+                error("')' attendue");
+            }
+            ++pos;
+            return f;
+        }
+        case '[':
+            ++pos;
+            return position(parseClass());
+        case '.': {
+            ++pos;
+            vector<char> all;
+            for (char d = firstPrintable; d <= lastPrintable; ++d) {
+                all.push_back(d);
+            }
+            return position(all);
+        }
+        case '*':
+        case '+':
+        case '?':
+            error(string("opérande manquant avant '") + c + "'");
+        case '\\':
+            ++pos;
+            if (atEnd()) {
+                error("'\\' en fin d'expression");
+            }
+            return position({re[pos++]});
+        default:
+            ++pos;
+            return position({c});
+        }
+    }
+
+    // Lit le contenu d'une classe, le '[' ayant déjà été consommé.
+    vector<char> parseClass() {
+        bool negated = false;
+        if (!atEnd() && re[pos] == '^') {
+            negated = true;
+            ++pos;
+        }
+        vector<bool> in(256, false);
+        bool empty = true;
+        while (!atEnd() && (re[pos] != ']' || empty)) {
+            unsigned char lo = classChar();
+            unsigned char hi = lo;
+            if (pos + 1 < re.size() && re[pos] == '-' && re[pos + 1] != ']') {
+                ++pos;
+                hi = classChar();
+                if (hi < lo) {
+                    error("intervalle vide dans une classe");
+                }
+            }
+            for (int d = lo; d <= hi; ++d) {
+                in[d] = true;
+            }
+            empty = false;
+        }
+        if (atEnd()) {
+            error("']' attendu");
+        }
+        ++pos;
+
+        vector<char> result;
+        if (negated) {
+            for (char d = firstPrintable; d <= lastPrintable; ++d) {
+                if (!in[static_cast<unsigned char>(d)]) {
+                    result.push_back(d);
+                }
+            }
+        } else {
+            for (int d = 0; d < 256; ++d) {
+                if (in[d]) {
+                    result.push_back(static_cast<char>(d));
+                }
+            }
+        }
+        if (result.empty()) {
+            error("classe de caractères vide");
+        }
+        return result;
+    }
+
+    unsigned char classChar() {
+        if (re[pos] == '\\') {
+            ++pos;
+            if (atEnd()) {
+                error("'\\' en fin d'expression");
+            }
+        }
+        return static_cast<unsigned char>(re[pos++]);
+    }
+
+    // Crée une nouvelle position étiquetée par les lettres données
+    Fragment position(const vector<char>& lets) {
+        int p = static_cast<int>(letters.size());
+        letters.push_back(lets);
+        follow.emplace_back();
+        Fragment f;
+        f.nullable = false;
+        f.first.push_back(p);
+        f.last.push_back(p);
+        return f;
+    }
+};
+
+} // namespace
+
+Automaton glushkov(const string& regex) {
+    return GlushkovParser(regex).compile();
+}
@@ -0,0 +1,164 @@
+#include "renumber.h"
+#include "adjacency.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+using namespace std;
+
+namespace {
+
+// Complète order avec les états non encore rangés, par numéro croissant
+void appendMissing(vector<int>& order, vector<bool>& placed) {
+    for (size_t q = 0; q < placed.size(); ++q) {
+        if (!placed[q]) {
+            order.push_back(static_cast<int>(q));
+        }
+    }
+}
+
+} // namespace
+
+vector<int> bfsOrder(const Automaton& aut) {
+    Adjacency adj(aut);
+    vector<bool> placed(aut.size(), false);
+    vector<int> order;
+    for (int q : aut.get_inits()) {
+        if (!placed[q]) {
+            placed[q] = true;
+            order.push_back(q);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        int q = order[head];
+        for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+            if (!placed[e->state]) {
+                placed[e->state] = true;
+                order.push_back(e->state);
+            }
+        }
+    }
+    appendMissing(order, placed);
+    return order;
+}
+
+vector<int> dfsOrder(const Automaton& aut) {
+    Adjacency adj(aut);
+    vector<bool> placed(aut.size(), false);
+    vector<int> order;
+    // Pile de (état, prochaine transition sortante à examiner)
+    vector<pair<int, const Adjacency::Edge*>> stack;
+    for (int init : aut.get_inits()) {
+        if (placed[init]) {
+            continue;
+        }
+        placed[init] = true;
+        order.push_back(init);
+        stack.emplace_back(init, adj.out_begin(init));
+        while (!stack.empty()) {
+            int q = stack.back().first;
+            const Adjacency::Edge*& e = stack.back().second;
+            if (e == adj.out_end(q)) {
+                stack.pop_back();
+                continue;
+            }
+            int next = (e++)->state;
+            if (!placed[next]) {
+                placed[next] = true;
+                order.push_back(next);
+                stack.emplace_back(next, adj.out_begin(next));
+            }
+        }
+    }
+    appendMissing(order, placed);
+    return order;
+}
+
+vector<uint64_t> visitCounts(const DfaTable& table, const vector<string>& samples) {
+    vector<uint64_t> counts(table.size(), 0);
+    for (const string& w : samples) {
+        int q = table.initial();
+        if (q < 0) {
+            break;
+        }
+        ++counts[q];
+        for (char c : w) {
+            q = table.next(q, c);
+            if (q < 0) {
+                break;
+            }
+            ++counts[q];
+        }
+    }
+    return counts;
+}
+
+vector<int> profileOrder(const vector<uint64_t>& counts, const vector<int>& base) {
+    vector<int> order = base;
+    if (order.empty()) {
+        order.resize(counts.size());
+        iota(order.begin(), order.end(), 0);
+    }
+    inversePermutation(order, static_cast<int>(counts.size()));
+    // Classe de fréquence : position du bit de poids fort du compteur
+    auto bucket = [&counts](int q) {
+        int b = 0;
+        for (uint64_t c = counts[q]; c != 0; c >>= 1) {
+            ++b;
+        }
+        return b;
+    };
+    stable_sort(order.begin(), order.end(),
+                [&bucket](int p, int q) { return bucket(p) > bucket(q); });
+    return order;
+}
+
+vector<int> inversePermutation(const vector<int>& order, int n) {
+    if (order.size() != static_cast<size_t>(n)) {
+        throw invalid_argument("renumber : l'ordre ne contient pas tous les états");
+    }
+    vector<int> inverse(n, -1);
+    for (int i = 0; i < n; ++i) {
+        int q = order[i];
+        if (q < 0 || q >= n || inverse[q] >= 0) {
+            throw invalid_argument("renumber : l'ordre n'est pas une permutation");
+        }
+        inverse[q] = i;
+    }
+    return inverse;
+}
+
+Automaton renumber(const Automaton& aut, const vector<int>& order) {
+    vector<int> old2new = inversePermutation(order, aut.size());
+
+    Automaton result;
+    for (int i = 0; i < aut.size(); ++i) {
+        result.newstate();
+    }
+    result.add_letter(aut.get_alphabet());
+    for (int q : aut.get_inits()) {
+        result.add_init(old2new[q]);
+    }
+
+    // Transitions déjà distinctes : la permutation les garde distinctes
+    vector<tuple<int, char, int>> trans;
+    trans.reserve(aut.get_trans().size());
+    for (const auto& t : aut.get_trans()) {
+        trans.emplace_back(old2new[get<0>(t)], get<1>(t), old2new[get<2>(t)]);
+    }
+    sort(trans.begin(), trans.end());
+    for (const auto& t : trans) {
+        result.add_trans_unchecked(get<0>(t), get<1>(t), get<2>(t));
+    }
+
+    vector<int> finals;
+    for (int q : aut.get_finals()) {
+        finals.push_back(old2new[q]);
+    }
+    sort(finals.begin(), finals.end());
+    for (int q : finals) {
+        result.add_final_unchecked(q);
+    }
+    return result;
+}
@@ -0,0 +1,190 @@
+#include "search.h"
+#include "operations.h"
+#include <cstring>
+#include <sstream>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Première position >= pos de text contenant l'un des n (2 ou 3) octets bytes
+size_t findAnyOf(string_view text, size_t pos, const unsigned char* bytes, size_t n) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+#if defined(__SSE2__)
+    __m128i b0 = _mm_set1_epi8(static_cast<char>(bytes[0]));
+    __m128i b1 = _mm_set1_epi8(static_cast<char>(bytes[1]));
+    __m128i b2 = _mm_set1_epi8(static_cast<char>(bytes[n - 1]));
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, b0), _mm_cmpeq_epi8(chunk, b1)),
+                                  _mm_cmpeq_epi8(chunk, b2));
+        int mask = _mm_movemask_epi8(eq);
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        unsigned char c = data[pos];
+        if (c == bytes[0] || c == bytes[1] || c == bytes[n - 1]) {
+            return pos;
+        }
+    }
+    return string_view::npos;
+}
+
+} // namespace
+
+Searcher::Searcher(const Automaton& aut, MatchSemantics semantics)
+    : dfa(determinize(trim(aut))), semantics(semantics), kind(All), isFirst() {
+    int q = dfa.initial();
+    if (q < 0 || dfa.is_final(q)) {
+        return;     // Aucun mot, ou mot vide reconnu : pas de préfiltre
+    }
+    for (int c = 0; c < 256; ++c) {
+        if (dfa.next(q, static_cast<char>(c)) >= 0) {
+            isFirst[c] = true;
+            firsts.push_back(static_cast<unsigned char>(c));
+        }
+    }
+
+    // Préfixe littéral : chaîne d'états non finaux n'ayant qu'un successeur
+    while (!dfa.is_final(q)) {
+        int only = -1;
+        int next = -1;
+        for (int c = 0; c < 256 && only != -2; ++c) {
+            int t = dfa.next(q, static_cast<char>(c));
+            if (t >= 0) {
+                if (only == -1) {
+                    only = c;
+                    next = t;
+                } else {
+                    only = -2;
+                }
+            }
+        }
+        if (only < 0 || literal.size() >= 64) {
+            break;
+        }
+        literal += static_cast<char>(only);
+        q = next;
+    }
+
+    if (literal.size() >= 2) {
+        kind = Literal;
+    } else if (firsts.size() == 1) {
+        kind = OneByte;
+    } else if (firsts.size() == 2 || firsts.size() == 3) {
+        kind = FewBytes;
+    } else {
+        kind = ByteSet;     // Aussi pour le langage vide : aucun candidat
+    }
+}
+
+size_t Searcher::candidate(string_view text, size_t pos) const {
+    if (pos > text.size()) {
+        return string_view::npos;
+    }
+    switch (kind) {
+    case All:
+        return pos;
+    case Literal:
+        return text.find(literal, pos);
+    case OneByte: {
+        const void* p = memchr(text.data() + pos, firsts[0], text.size() - pos);
+        return p == nullptr ? string_view::npos : static_cast<const char*>(p) - text.data();
+    }
+    case FewBytes:
+        return findAnyOf(text, pos, firsts.data(), firsts.size());
+    case ByteSet:
+        for (; pos < text.size(); ++pos) {
+            if (isFirst[static_cast<unsigned char>(text[pos])]) {
+                return pos;
+            }
+        }
+        return string_view::npos;
+    }
+    return pos;
+}
+
+long long Searcher::matchAt(string_view text, size_t start) const {
+    int q = dfa.initial();
+    if (q < 0) {
+        return -1;
+    }
+    long long end = dfa.is_final(q) ? static_cast<long long>(start) : -1;
+    if (end >= 0 && semantics == MatchSemantics::LeftmostFirst) {
+        return end;
+    }
+    // Après trim, un état sans successeur ne mène plus à aucun état final
+    for (size_t i = start; i < text.size(); ++i) {
+        q = dfa.next(q, text[i]);
+        if (q < 0) {
+            break;
+        }
+        if (dfa.is_final(q)) {
+            end = static_cast<long long>(i + 1);
+            if (semantics == MatchSemantics::LeftmostFirst) {
+                break;
+            }
+        }
+    }
+    return end;
+}
+
+bool Searcher::find(string_view text, size_t pos, Match& match) const {
+    if (dfa.initial() < 0) {
+        return false;
+    }
+    for (size_t start = candidate(text, pos); start != string_view::npos;
+         start = candidate(text, start + 1)) {
+        long long end = matchAt(text, start);
+        if (end >= 0) {
+            match = {start, static_cast<size_t>(end)};
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<Match> Searcher::findAll(string_view text) const {
+    vector<Match> matches;
+    Match m;
+    size_t pos = 0;
+    while (find(text, pos, m)) {
+        matches.push_back(m);
+        pos = m.end > m.start ? m.end : m.end + 1;
+    }
+    return matches;
+}
+
+string Searcher::prefilter() const {
+    ostringstream os;
+    switch (kind) {
+    case All:
+        os << "aucun";
+        break;
+    case Literal:
+        os << "litteral \"" << literal << "\"";
+        break;
+    case OneByte:
+    case FewBytes:
+    case ByteSet:
+        os << firsts.size() << " premier(s) octet(s) possible(s)";
+        break;
+    }
+    return os.str();
+}
+
+MemoryUsage Searcher::memory_usage() const {
+    MemoryUsage usage;
+    usage.add("dfa", dfa.memory_usage());
+    usage.add("literal", literal.size(), literal.capacity());
+    usage.add_vector("firsts", firsts);
+    usage.add("isFirst", sizeof(isFirst), sizeof(isFirst));
+    return usage;
+}
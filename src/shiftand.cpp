@@ -0,0 +1,71 @@
+#include "shiftand.h"
+#include "operations.h"
+
+using namespace std;
+
+Matcher::Matcher(const Automaton& aut) : engine(makeEngine(aut)) {}
+
+Matcher::Engine Matcher::makeEngine(const Automaton& aut) {
+    if (aut.size() <= ShiftAndMatcher<1>::maxStates) {
+        return Engine(in_place_type<ShiftAndMatcher<1>>, aut);
+    }
+    if (aut.size() <= ShiftAndMatcher<2>::maxStates) {
+        return Engine(in_place_type<ShiftAndMatcher<2>>, aut);
+    }
+    if (aut.size() <= ShiftAndMatcher<4>::maxStates) {
+        return Engine(in_place_type<ShiftAndMatcher<4>>, aut);
+    }
+    return Engine(in_place_type<Automaton>, aut);
+}
+
+bool Matcher::appartient(const string& word) const {
+    switch (engine.index()) {
+    case 1:
+        return get<ShiftAndMatcher<1>>(engine).appartient(word);
+    case 2:
+        return get<ShiftAndMatcher<2>>(engine).appartient(word);
+    case 3:
+        return get<ShiftAndMatcher<4>>(engine).appartient(word);
+    default:
+        return ::appartient(get<Automaton>(engine), word);
+    }
+}
+
+int Matcher::width() const {
+    switch (engine.index()) {
+    case 1:
+        return ShiftAndMatcher<1>::maxStates;
+    case 2:
+        return ShiftAndMatcher<2>::maxStates;
+    case 3:
+        return ShiftAndMatcher<4>::maxStates;
+    default:
+        return 0;
+    }
+}
+
+bool Matcher::homogeneous() const {
+    switch (engine.index()) {
+    case 1:
+        return get<ShiftAndMatcher<1>>(engine).homogeneous();
+    case 2:
+        return get<ShiftAndMatcher<2>>(engine).homogeneous();
+    case 3:
+        return get<ShiftAndMatcher<4>>(engine).homogeneous();
+    default:
+        return false;
+    }
+}
+
+MemoryUsage Matcher::memory_usage() const {
+    switch (engine.index()) {
+    case 1:
+        return get<ShiftAndMatcher<1>>(engine).memory_usage();
+    case 2:
+        return get<ShiftAndMatcher<2>>(engine).memory_usage();
+    case 3:
+        return get<ShiftAndMatcher<4>>(engine).memory_usage();
+    default:
+        return get<Automaton>(engine).memory_usage();
+    }
+}
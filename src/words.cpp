@@ -0,0 +1,261 @@
+#include "words.h"
+#include "adjacency.h"
+#include "lazy.h"
+#include "operations.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// Ordre des lettres de std::string : celui des unsigned char
+bool letterLess(char a, char b) {
+    return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+}
+
+// Énumération en profondeur sur les ensembles d'états, élaguée par
+// viable[r] : états depuis lesquels un état final est atteignable en
+// exactement r lettres. Chaque branche explorée produit donc au moins un mot.
+class Enumerator {
+public:
+    Enumerator(const Adjacency& adj, const vector<vector<bool>>& viable,
+               const function<bool(const string&)>& f)
+        : adj(adj), viable(viable), f(f), mark(adj.size(), false) {}
+
+    // Retourne false si f a demandé l'arrêt
+    bool run(const vector<int>& states, size_t remaining) {
+        if (remaining == 0) {
+            return f(word);
+        }
+        vector<char> letters;
+        for (int q : states) {
+            for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+                letters.push_back(e->letter);
+            }
+        }
+        sort(letters.begin(), letters.end(), letterLess);
+        letters.erase(unique(letters.begin(), letters.end()), letters.end());
+
+        const vector<bool>& useful = viable[remaining - 1];
+        for (char c : letters) {
+            vector<int> next;
+            for (int q : states) {
+                auto range = adj.out(q, c);
+                for (const Adjacency::Edge* e = range.first; e != range.second; ++e) {
+                    if (useful[e->state] && !mark[e->state]) {
+                        mark[e->state] = true;
+                        next.push_back(e->state);
+                    }
+                }
+            }
+            for (int q : next) {
+                mark[q] = false;
+            }
+            if (!next.empty()) {
+                word.push_back(c);
+                bool go = run(next, remaining - 1);
+                word.pop_back();
+                if (!go) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    const Adjacency& adj;
+    const vector<vector<bool>>& viable;
+    const function<bool(const string&)>& f;
+    vector<bool> mark;      // Marquage temporaire pour dédoublonner next
+    string word;
+};
+
+uint64_t addMod(uint64_t a, uint64_t b, uint64_t modulus) {
+    if (modulus == 0) {
+        return a + b;       // Débordement naturel : modulo 2^64
+    }
+    return a >= modulus - b ? a - (modulus - b) : a + b;
+}
+
+bool isDeterministic(const Automaton& aut, const Adjacency& adj) {
+    if (aut.get_inits().size() > 1) {
+        return false;
+    }
+    for (int q = 0; q < adj.size(); ++q) {
+        for (const Adjacency::Edge* e = adj.out_begin(q); e + 1 < adj.out_end(q); ++e) {
+            if (e->letter == (e + 1)->letter) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Dénombrement sur un automate déterministe à la demande : seuls les
+// ensembles d'états atteints en au plus maxLength lettres sont construits.
+// Les états du noeud sont numérotés dans l'ordre de leur construction.
+vector<uint64_t> countLazy(LazyAutomaton dfa, size_t maxLength, uint64_t modulus) {
+    vector<uint64_t> counts(maxLength + 1, 0);
+    vector<uint64_t> current;
+    vector<int> frontier;
+    for (int s : dfa->initials()) {
+        current.resize(max(current.size(), static_cast<size_t>(s) + 1), 0);
+        current[s] = modulus == 1 ? 0 : 1;
+        frontier.push_back(s);
+    }
+    vector<uint64_t> next;
+    for (size_t l = 0; l <= maxLength && !frontier.empty(); ++l) {
+        for (int s : frontier) {
+            if (dfa->is_final(s)) {
+                counts[l] = addMod(counts[l], current[s], modulus);
+            }
+        }
+        if (l == maxLength) {
+            break;
+        }
+        vector<int> reached;
+        for (int s : frontier) {
+            for (char c : dfa->out_letters(s)) {
+                for (int t : dfa->successors(s, c)) {
+                    if (static_cast<size_t>(t) >= next.size()) {
+                        next.resize(t + 1, 0);
+                    }
+                    if (next[t] == 0) {
+                        reached.push_back(t);
+                    }
+                    next[t] = addMod(next[t], current[s], modulus);
+                }
+            }
+        }
+        for (int s : frontier) {
+            current[s] = 0;
+        }
+        current.resize(max(current.size(), next.size()), 0);
+        frontier.clear();
+        for (int t : reached) {
+            if (next[t] != 0) {
+                current[t] = next[t];
+                frontier.push_back(t);
+            }
+            next[t] = 0;
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+bool shortestWord(const Automaton& aut, string& word) {
+    Adjacency adj(aut);
+    int n = adj.size();
+    vector<bool> final(n, false);
+    for (int q : aut.get_finals()) {
+        final[q] = true;
+    }
+
+    // Parcours en largeur ; parent[q] et letter[q] décrivent la transition
+    // par laquelle q a été découvert.
+    vector<int> parent(n, -2);
+    vector<char> letter(n, 0);
+    vector<int> queue;
+    for (int q : aut.get_inits()) {
+        if (parent[q] == -2) {
+            parent[q] = -1;
+            queue.push_back(q);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int q = queue[head];
+        if (final[q]) {
+            string w;
+            for (int p = q; parent[p] >= 0; p = parent[p]) {
+                w.push_back(letter[p]);
+            }
+            reverse(w.begin(), w.end());
+            word = w;
+            return true;
+        }
+        for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+            if (parent[e->state] == -2) {
+                parent[e->state] = q;
+                letter[e->state] = e->letter;
+                queue.push_back(e->state);
+            }
+        }
+    }
+    return false;
+}
+
+void enumerateWords(const Automaton& aut, size_t maxLength,
+                    const function<bool(const string&)>& f) {
+    Adjacency adj(aut);
+    int n = adj.size();
+
+    // viable[r] calculé couche par couche à partir des états finaux
+    vector<vector<bool>> viable(maxLength + 1, vector<bool>(n, false));
+    for (int q : aut.get_finals()) {
+        viable[0][q] = true;
+    }
+    for (size_t r = 1; r <= maxLength; ++r) {
+        for (int q = 0; q < n; ++q) {
+            if (viable[r - 1][q]) {
+                for (const Adjacency::Edge* e = adj.in_begin(q); e != adj.in_end(q); ++e) {
+                    viable[r][e->state] = true;
+                }
+            }
+        }
+    }
+
+    vector<int> inits(aut.get_inits().begin(), aut.get_inits().end());
+    Enumerator enumerator(adj, viable, f);
+    for (size_t length = 0; length <= maxLength; ++length) {
+        vector<int> start;
+        for (int q : inits) {
+            if (viable[length][q]) {
+                start.push_back(q);
+            }
+        }
+        if (!start.empty() && !enumerator.run(start, length)) {
+            return;
+        }
+    }
+}
+
+vector<uint64_t> countWords(const Automaton& aut, size_t maxLength, uint64_t modulus) {
+    Adjacency adj(aut);
+    if (!isDeterministic(aut, adj)) {
+        // Les états non co-accessibles ne changent pas les comptes mais
+        // multiplient les ensembles d'états : ils sont retirés d'abord
+        return countLazy(lazyDeterminize(lazy(trim(aut))), maxLength, modulus);
+    }
+
+    int n = adj.size();
+    vector<uint64_t> counts(maxLength + 1, 0);
+    if (aut.get_inits().is_empty()) {
+        return counts;
+    }
+
+    // current[q] : nombre de mots de longueur l menant de l'état initial à q
+    vector<uint64_t> current(n, 0);
+    vector<uint64_t> next(n, 0);
+    current[aut.get_inits().at(0)] = modulus == 1 ? 0 : 1;
+    for (size_t l = 0; l <= maxLength; ++l) {
+        for (int q : aut.get_finals()) {
+            counts[l] = addMod(counts[l], current[q], modulus);
+        }
+        if (l == maxLength) {
+            break;
+        }
+        fill(next.begin(), next.end(), 0);
+        for (int q = 0; q < n; ++q) {
+            if (current[q] != 0) {
+                for (const Adjacency::Edge* e = adj.out_begin(q); e != adj.out_end(q); ++e) {
+                    next[e->state] = addMod(next[e->state], current[q], modulus);
+                }
+            }
+        }
+        current.swap(next);
+    }
+    return counts;
+}